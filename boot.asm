@@ -1,9 +1,25 @@
 ; 64-bit kernel için bootloader
 bits 32
+MB_FLAGS equ 0x3            ; Modülleri sayfa hizala + bellek haritası iste
+
 section .multiboot
+align 4
     dd 0x1BADB002            ; Multiboot sihirli sayısı
-    dd 0x0                   ; Bayraklar
-    dd - (0x1BADB002 + 0x0)  ; Kontrol toplamı
+    dd MB_FLAGS              ; Bayraklar
+    dd - (0x1BADB002 + MB_FLAGS) ; Kontrol toplamı
+
+; Multiboot2 başlığı (GRUB'un multiboot2 komutu için)
+align 8
+mb2_header_start:
+    dd 0xE85250D6            ; Multiboot2 sihirli sayısı
+    dd 0                     ; Mimari (i386 korumalı mod)
+    dd mb2_header_end - mb2_header_start ; Başlık uzunluğu
+    dd - (0xE85250D6 + 0 + (mb2_header_end - mb2_header_start)) ; Kontrol toplamı
+    ; Bitiş etiketi
+    dw 0
+    dw 0
+    dd 8
+mb2_header_end:
 
 section .text
 global start
@@ -12,6 +28,8 @@ extern kernel_main
 start:
     cli                     ; Kesmeleri devre dışı bırak
     mov esp, stack_top      ; Stack pointer'ı ayarla
+    mov edi, eax            ; Multiboot sihirli sayısı (kernel_main 1. argüman)
+    mov esi, ebx            ; Multiboot bilgi yapısı adresi (kernel_main 2. argüman)
     call check_multiboot    ; Multiboot ile başlatıldığını kontrol et
     call check_cpuid        ; CPUID desteğini kontrol et
     call check_long_mode    ; Long mode desteğini kontrol et
@@ -26,8 +44,11 @@ start:
     hlt
 
 check_multiboot:
-    cmp eax, 0x36d76289
+    cmp eax, 0x2BADB002     ; Multiboot
+    je .ok
+    cmp eax, 0x36d76289     ; Multiboot2
     jne .no_multiboot
+.ok:
     ret
 .no_multiboot:
     mov al, "0"
@@ -125,6 +146,8 @@ error:
 
 section .bss
 align 4096
+global boot_pml4
+boot_pml4:
 p4_table:
     resb 4096
 p3_table:
@@ -155,7 +178,9 @@ long_mode_start:
     mov fs, ax
     mov gs, ax
     
-    ; kernel_main fonksiyonunu çağır
+    ; kernel_main(magic, multiboot_info) - üst 32 biti temizle
+    mov edi, edi
+    mov esi, esi
     call kernel_main
     
     ; kernel_main'den dönülürse sonsuz döngüye gir
@@ -4,6 +4,13 @@
 #include "process.h"
 #include "syscall.h"
 #include "signals.h"
+#include "slab.h"
+#include "paging.h"
+#include "ksm.h"
+#include "swap.h"
+#include "zram.h"
+#include "dma.h"
+#include "numa.h"
 
 // Komut listesi
 command_t commands[] = {
@@ -108,6 +115,48 @@ command_t commands[] = {
         cmd_exit, 
         "Kabuktan çık", 
         "exit [durum]"
+    },
+    {
+        "slabinfo", 
+        cmd_slabinfo, 
+        "Nesne önbelleklerinin kullanımını göster", 
+        "slabinfo"
+    },
+    {
+        "meminfo", 
+        cmd_meminfo, 
+        "Fiziksel bellek kullanımını göster", 
+        "meminfo"
+    },
+    {
+        "ksminfo", 
+        cmd_ksminfo, 
+        "Aynı içerikli sayfa birleştirme durumunu göster", 
+        "ksminfo"
+    },
+    {
+        "swapinfo", 
+        cmd_swapinfo, 
+        "Takas alanı kullanımını göster", 
+        "swapinfo"
+    },
+    {
+        "zraminfo", 
+        cmd_zraminfo, 
+        "Sıkıştırılmış bellek takasının durumunu göster", 
+        "zraminfo"
+    },
+    {
+        "dmainfo", 
+        cmd_dmainfo, 
+        "DMA tampon havuzunun kullanımını göster", 
+        "dmainfo"
+    },
+    {
+        "numainfo", 
+        cmd_numainfo, 
+        "NUMA düğümlerinin bellek kullanımını ve uzaklıklarını göster", 
+        "numainfo"
     }
 };
 
@@ -639,6 +688,221 @@ int cmd_exit(int argc, char** argv) {
     return 0; // Buraya asla ulaşılmaz
 }
 
+// Nesne önbelleklerini listele - slabinfo komutu
+int cmd_slabinfo(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    
+    terminal_writestring("AKTIF\tTOPLAM\tBOYUT\tSLAB\tAD\n");
+    terminal_writestring("-----------------------------------\n");
+    
+    for (kmem_cache_t* cache = kmem_cache_first(); cache; cache = cache->next) {
+        char num_str[12];
+        
+        // Kullanımdaki nesneler
+        int_to_string(cache->active_objects, num_str);
+        terminal_writestring(num_str);
+        terminal_writestring("\t");
+        
+        // Toplam nesneler
+        int_to_string(cache->total_objects, num_str);
+        terminal_writestring(num_str);
+        terminal_writestring("\t");
+        
+        // Nesne boyutu
+        int_to_string(cache->object_size, num_str);
+        terminal_writestring(num_str);
+        terminal_writestring("\t");
+        
+        // Slab sayısı
+        int_to_string(cache->slab_count, num_str);
+        terminal_writestring(num_str);
+        terminal_writestring("\t");
+        
+        // Önbellek adı
+        terminal_writestring(cache->name);
+        terminal_writestring("\n");
+    }
+    
+    return 0;
+}
+
+// Tek satırlık bellek bilgisi yazdır
+static void meminfo_line(const char* label, uint64_t value, const char* unit) {
+    char num_str[12];
+    
+    terminal_writestring(label);
+    int_to_string(value, num_str);
+    terminal_writestring(num_str);
+    terminal_writestring(unit);
+    terminal_writestring("\n");
+}
+
+// Fiziksel bellek kullanımını göster - meminfo komutu
+int cmd_meminfo(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    
+    const physical_memory_manager_t* info = paging_get_pmm_info();
+    
+    meminfo_line("Toplam:         ", info->total_memory / 1024, " KB");
+    meminfo_line("Serbest:        ", info->free_memory / 1024, " KB");
+    meminfo_line("Kullanilan:     ", info->used_memory / 1024, " KB");
+    meminfo_line("Ayrilmis:       ", info->reserved_memory / 1024, " KB");
+    
+    // Sıfır sayfa havuzu
+    meminfo_line("Sifir havuzu:   ", info->zero_pool_count, " sayfa");
+    meminfo_line("Havuz isabet:   ", info->zero_pool_hits, "");
+    meminfo_line("Havuz iskalama: ", info->zero_pool_misses, "");
+    
+    // Sayfa geri kazanımı
+    meminfo_line("Esik en dusuk:  ", info->watermark_min, " sayfa");
+    meminfo_line("Esik dusuk:     ", info->watermark_low, " sayfa");
+    meminfo_line("Esik yuksek:    ", info->watermark_high, " sayfa");
+    meminfo_line("LRU etkin:      ", info->lru_active, " sayfa");
+    meminfo_line("LRU etkin degil:", info->lru_inactive, " sayfa");
+    meminfo_line("Geri kazanilan: ", info->reclaimed_pages, " sayfa");
+    meminfo_line("Bellek baskisi: ", info->pressure_events, "");
+    
+    return 0;
+}
+
+// Sayfa birleştirme durumunu göster - ksminfo komutu
+int cmd_ksminfo(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    
+    ksm_info_t info;
+    ksm_get_info(&info);
+    
+    meminfo_line("Tarama turu:       ", info.full_scans, "");
+    meminfo_line("Taranan sayfa:     ", info.pages_scanned, "");
+    meminfo_line("Birlestirilen:     ", info.pages_merged, "");
+    meminfo_line("Ortak cerceve:     ", info.pages_shared, "");
+    meminfo_line("Paylasan sayfa:    ", info.pages_sharing, "");
+    meminfo_line("Kazanilan bellek:  ", info.pages_sharing * PAGE_SIZE / 1024, " KB");
+    
+    return 0;
+}
+
+// Takas alanı durumunu göster - swapinfo komutu
+int cmd_swapinfo(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    
+    swap_info_t info;
+    swap_get_info(&info);
+    
+    if (info.total_slots == 0) {
+        terminal_writestring("Takas alani yok.\n");
+        return 0;
+    }
+    
+    meminfo_line("Toplam:            ", info.total_slots * PAGE_SIZE / 1024, " KB");
+    meminfo_line("Kullanilan:        ", info.used_slots * PAGE_SIZE / 1024, " KB");
+    meminfo_line("Yazilan sayfa:     ", info.pages_out, "");
+    meminfo_line("Okunan sayfa:      ", info.pages_in, "");
+    meminfo_line("Yazilan kume:      ", info.clusters_written, "");
+    meminfo_line("Tampondan okunan:  ", info.cluster_hits, "");
+    meminfo_line("G/C hatasi:        ", info.io_errors, "");
+    
+    return 0;
+}
+
+// Sıkıştırılmış bellek takasının durumunu göster - zraminfo komutu
+int cmd_zraminfo(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    
+    zram_info_t info;
+    zram_get_info(&info);
+    
+    if (info.max_pages == 0) {
+        terminal_writestring("Sikistirilmis bellek takasi kapali.\n");
+        return 0;
+    }
+    
+    // Oran tek değerle dolu sayfalar dışındaki sayfalar üzerinden hesaplanır
+    uint64_t compressed_pages = info.stored_pages - info.same_pages;
+    uint64_t stored_kb = info.stored_pages * PAGE_SIZE / 1024;
+    uint64_t pool_kb = info.pool_pages * PAGE_SIZE / 1024;
+    
+    meminfo_line("Saklanan sayfa:    ", info.stored_pages, "");
+    meminfo_line("Tek degerli sayfa: ", info.same_pages, "");
+    meminfo_line("Sikistirilmis veri:", info.compressed_bytes / 1024, " KB");
+    meminfo_line("Havuz:             ", pool_kb, " KB");
+    meminfo_line("Havuz siniri:      ", info.pool_limit * PAGE_SIZE / 1024, " KB");
+    meminfo_line("Kazanilan bellek:  ", stored_kb > pool_kb ? stored_kb - pool_kb : 0, " KB");
+    meminfo_line("Ortalama oran (%): ", compressed_pages ? info.compressed_bytes * 100 / (compressed_pages * PAGE_SIZE) : 0, "");
+    meminfo_line("Oran < %12,5:      ", info.ratio[0], " sayfa");
+    meminfo_line("Oran < %25:        ", info.ratio[1], " sayfa");
+    meminfo_line("Oran < %50:        ", info.ratio[2], " sayfa");
+    meminfo_line("Reddedilen:        ", info.rejected, " sayfa");
+    meminfo_line("Sikistirma ort.:   ", info.compress_count ? info.compress_cycles / info.compress_count : 0, " cevrim");
+    meminfo_line("Sikistirma en cok: ", info.compress_max_cycles, " cevrim");
+    meminfo_line("Acma ort.:         ", info.decompress_count ? info.decompress_cycles / info.decompress_count : 0, " cevrim");
+    meminfo_line("Acma en cok:       ", info.decompress_max_cycles, " cevrim");
+    
+    return 0;
+}
+
+// DMA tampon havuzunun durumunu göster - dmainfo komutu
+int cmd_dmainfo(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    
+    dma_info_t info;
+    dma_get_info(&info);
+    
+    if (info.pool_size == 0) {
+        terminal_writestring("DMA havuzu yok.\n");
+        return 0;
+    }
+    
+    meminfo_line("Havuz baslangici: ", info.pool_start / 1024, " KB");
+    meminfo_line("Havuz:            ", info.pool_size / 1024, " KB");
+    meminfo_line("Kullanilan:       ", info.used_bytes / 1024, " KB");
+    meminfo_line("Tampon:           ", info.allocations, "");
+    meminfo_line("Karsilanamayan:   ", info.failures, "");
+    
+    return 0;
+}
+
+// NUMA düğümlerini göster - numainfo komutu
+int cmd_numainfo(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    
+    const physical_memory_manager_t* pmm = paging_get_pmm_info();
+    const numa_info_t* numa = numa_get_info();
+    char num_str[20];
+    
+    for (uint32_t n = 0; n < pmm->node_count; n++) {
+        const pmm_node_t* node = &pmm->nodes[n];
+        
+        terminal_writestring("Dugum ");
+        int_to_string(n, num_str);
+        terminal_writestring(num_str);
+        terminal_writestring(n == numa_current_node() ? " (bu islemci)\n" : "\n");
+        
+        meminfo_line("  Toplam:         ", node->total_pages * PAGE_SIZE / 1024, " KB");
+        meminfo_line("  Serbest:        ", node->free_pages * PAGE_SIZE / 1024, " KB");
+        meminfo_line("  Yerel tahsis:   ", node->local_allocs, "");
+        meminfo_line("  Uzak tahsis:    ", node->remote_allocs, "");
+        
+        // SLIT satırı: bu düğümden her düğüme göreli uzaklık
+        terminal_writestring("  Uzakliklar:     ");
+        for (uint32_t to = 0; to < pmm->node_count; to++) {
+            int_to_string(numa->distance[n][to], num_str);
+            terminal_writestring(num_str);
+            terminal_writestring(" ");
+        }
+        terminal_writestring("\n");
+    }
+    
+    return 0;
+}
+
 // Yardım bilgisini yazdır
 void print_command_help(const command_t* cmd) {
     terminal_writestring("Komut: ");
@@ -40,6 +40,13 @@ int cmd_touch(int argc, char** argv);
 int cmd_clear(int argc, char** argv);
 int cmd_help(int argc, char** argv);
 int cmd_exit(int argc, char** argv);
+int cmd_slabinfo(int argc, char** argv);
+int cmd_meminfo(int argc, char** argv);
+int cmd_ksminfo(int argc, char** argv);
+int cmd_swapinfo(int argc, char** argv);
+int cmd_zraminfo(int argc, char** argv);
+int cmd_dmainfo(int argc, char** argv);
+int cmd_numainfo(int argc, char** argv);
 
 // Komut satırı ayrıştırma yardımcı işlevleri
 int parse_command_line(const char* command_line, char** argv, int max_args);
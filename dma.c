@@ -0,0 +1,165 @@
+#include "kernel.h"
+#include "dma.h"
+#include "paging.h"
+
+// paging_init'in ayırdığı havuz
+static uint64_t dma_pool_phys = 0;
+static uint64_t dma_blocks = 0;
+
+// Blok başına bir bit (1 = ayrılmış)
+static uint8_t dma_bitmap[DMA_MAX_BLOCKS / 8];
+
+static dma_info_t dma_stats;
+
+// Blok ayrılmış mı?
+static inline int dma_block_used(uint64_t block) {
+    return (dma_bitmap[block / 8] >> (block % 8)) & 1;
+}
+
+// Blok aralığını ayrılmış ya da boş olarak işaretle
+static void dma_blocks_set(uint64_t block, uint64_t count, int used) {
+    for (uint64_t b = block; b < block + count; b++) {
+        if (used) {
+            dma_bitmap[b / 8] |= (uint8_t)(1 << (b % 8));
+        } else {
+            dma_bitmap[b / 8] &= (uint8_t)~(1 << (b % 8));
+        }
+    }
+}
+
+// Kısıtlara uyan ilk boş blok dizisini bul (bulunamazsa dma_blocks döner)
+static uint64_t dma_find(uint64_t count, uint64_t align, uint64_t boundary, uint64_t limit) {
+    uint64_t size = count * DMA_BLOCK_SIZE;
+    uint64_t phys = (dma_pool_phys + align - 1) & ~(align - 1);
+
+    while (phys + size <= dma_pool_phys + dma_blocks * DMA_BLOCK_SIZE) {
+        // Adresler artarak ilerler; sınırı aşan ilk adayda arama biter
+        if (phys + size > limit) {
+            break;
+        }
+
+        // Sınırı aşacaksa bir sonraki sınırdan dene (ikisi de ikinin kuvveti, sınır hizalıdır)
+        if (boundary && (phys & ~(boundary - 1)) != ((phys + size - 1) & ~(boundary - 1))) {
+            phys = (phys + boundary - 1) & ~(boundary - 1);
+            phys = (phys + align - 1) & ~(align - 1);
+            continue;
+        }
+
+        uint64_t block = (phys - dma_pool_phys) / DMA_BLOCK_SIZE;
+        uint64_t used = block + count;
+        for (uint64_t b = block; b < block + count; b++) {
+            if (dma_block_used(b)) {
+                used = b;
+                break;
+            }
+        }
+        if (used == block + count) {
+            return block;
+        }
+
+        // Ayrılmış bloğun ardındaki ilk hizalı adresten devam et
+        phys = dma_pool_phys + (used + 1) * DMA_BLOCK_SIZE;
+        phys = (phys + align - 1) & ~(align - 1);
+    }
+
+    return dma_blocks;
+}
+
+// paging_init'in ayırdığı havuzu devral
+int dma_init() {
+    memset(dma_bitmap, 0, sizeof(dma_bitmap));
+    memset(&dma_stats, 0, sizeof(dma_stats));
+
+    const physical_memory_manager_t* pmm = paging_get_pmm_info();
+    uint64_t blocks = pmm->dma_pool_pages * PAGE_SIZE / DMA_BLOCK_SIZE;
+    if (blocks == 0) {
+        terminal_writestring("DMA havuzu yok.\n");
+        return 0;
+    }
+    if (blocks > DMA_MAX_BLOCKS) {
+        blocks = DMA_MAX_BLOCKS;
+    }
+
+    dma_pool_phys = pmm->dma_pool_start;
+    dma_blocks = blocks;
+    dma_stats.pool_start = dma_pool_phys;
+    dma_stats.pool_size = blocks * DMA_BLOCK_SIZE;
+
+    terminal_writestring("DMA havuzu hazir: ");
+    char size_str[20];
+    int_to_string(dma_stats.pool_size / 1024, size_str);
+    terminal_writestring(size_str);
+    terminal_writestring(" KB\n");
+    return 1;
+}
+
+// İstatistikleri al
+void dma_get_info(dma_info_t* info) {
+    *info = dma_stats;
+}
+
+// Kısıtlara uyan fiziksel olarak kesintisiz tampon ayır ve sıfırla
+int dma_alloc(uint64_t size, uint64_t align, uint64_t boundary, uint64_t limit, dma_buffer_t* buffer) {
+    buffer->virt = NULL;
+    buffer->phys = 0;
+    buffer->size = 0;
+
+    if (!dma_blocks || size == 0) {
+        return 0;
+    }
+
+    // Hizalama ve sınır ikinin kuvveti olmalı; tampon sınırdan büyük olamaz
+    if ((align & (align - 1)) || (boundary & (boundary - 1))) {
+        return 0;
+    }
+    if (align < DMA_BLOCK_SIZE) {
+        align = DMA_BLOCK_SIZE;
+    }
+
+    uint64_t count = (size + DMA_BLOCK_SIZE - 1) / DMA_BLOCK_SIZE;
+    if (boundary && count * DMA_BLOCK_SIZE > boundary) {
+        return 0;
+    }
+    if (limit == 0 || limit > DMA_LIMIT_4G) {
+        limit = DMA_LIMIT_4G;
+    }
+
+    uint64_t rflags = irq_save();
+    uint64_t block = dma_find(count, align, boundary, limit);
+    if (block == dma_blocks) {
+        dma_stats.failures++;
+        irq_restore(rflags);
+        return 0;
+    }
+    dma_blocks_set(block, count, 1);
+    dma_stats.used_bytes += count * DMA_BLOCK_SIZE;
+    dma_stats.allocations++;
+    irq_restore(rflags);
+
+    buffer->phys = dma_pool_phys + block * DMA_BLOCK_SIZE;
+    buffer->virt = phys_to_virt(buffer->phys);
+    buffer->size = count * DMA_BLOCK_SIZE;
+    memset(buffer->virt, 0, buffer->size);
+    return 1;
+}
+
+// Tamponu havuza geri ver
+void dma_free(dma_buffer_t* buffer) {
+    if (!buffer->size || buffer->phys < dma_pool_phys ||
+        buffer->phys + buffer->size > dma_pool_phys + dma_blocks * DMA_BLOCK_SIZE) {
+        return;
+    }
+
+    uint64_t block = (buffer->phys - dma_pool_phys) / DMA_BLOCK_SIZE;
+    uint64_t count = buffer->size / DMA_BLOCK_SIZE;
+
+    uint64_t rflags = irq_save();
+    dma_blocks_set(block, count, 0);
+    dma_stats.used_bytes -= count * DMA_BLOCK_SIZE;
+    dma_stats.allocations--;
+    irq_restore(rflags);
+
+    buffer->virt = NULL;
+    buffer->phys = 0;
+    buffer->size = 0;
+}
\ No newline at end of file
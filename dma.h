@@ -0,0 +1,44 @@
+#ifndef DMA_H
+#define DMA_H
+
+#include <stdint.h>
+
+// Havuz bu boyutta bloklarla dağıtılır (en küçük ayırma ve hizalama)
+#define DMA_BLOCK_SIZE   256
+
+// Havuz bit eşlemi üst sınırı (paging.h'deki PMM_DMA_POOL_PAGES ile aynı)
+#define DMA_MAX_BLOCKS   (1024 * 4096 / DMA_BLOCK_SIZE)
+
+// Sık kullanılan adres sınırları (dma_alloc'un limit parametresi)
+#define DMA_LIMIT_4G     0x100000000ULL   // 32 bit adresli veri yolu yöneticileri
+#define DMA_LIMIT_16M    0x1000000ULL     // ISA DMA denetleyicisi
+
+// Ayrılan tampon: CPU ve cihaz aynı belleği farklı adreslerle görür
+// x86'da veri yolu yöneticisi erişimleri önbelleği gözetler, doğrudan eşleme
+// önbellekli kalsa da tampon tutarlıdır (ayrıca temizleme gerekmez)
+typedef struct {
+    void* virt;                  // Kernel adresi (doğrudan eşleme)
+    uint64_t phys;               // Cihaza verilecek fiziksel adres
+    uint64_t size;               // Ayrılan boyut (blok katına yuvarlanmış)
+} dma_buffer_t;
+
+// DMA havuzu istatistikleri
+typedef struct {
+    uint64_t pool_start;         // Havuzun fiziksel adresi
+    uint64_t pool_size;          // Havuz boyutu (bayt, 0 = havuz yok)
+    uint64_t used_bytes;         // Ayrılmış bayt
+    uint64_t allocations;        // Kullanımdaki tampon sayısı
+    uint64_t failures;           // Karşılanamayan istek
+} dma_info_t;
+
+// DMA havuzu işlevleri
+int dma_init();
+void dma_get_info(dma_info_t* info);
+
+// Fiziksel olarak kesintisiz, sıfırlanmış tampon ayır (1 = başarılı)
+// align: ikinin kuvveti hizalama; boundary: tamponun aşmaması gereken ikinin
+// kuvveti sınır (0 = yok); limit: tamponun bitmesi gereken en yüksek adres (0 = 4 GB)
+int dma_alloc(uint64_t size, uint64_t align, uint64_t boundary, uint64_t limit, dma_buffer_t* buffer);
+void dma_free(dma_buffer_t* buffer);
+
+#endif // DMA_H
\ No newline at end of file
@@ -1,9 +1,13 @@
 #include "kernel.h"
 #include "filesystem.h"
+#include "slab.h"
 
 // Global dosya sistemi bilgisi
 static fs_info_t fs_info;
 
+// Açık dosya yapıları için nesne önbelleği
+static kmem_cache_t* file_cache = NULL;
+
 // ATA disk okuma fonksiyonu prototipi
 extern int ata_read_sectors(uint32_t lba, uint8_t sector_count, void* buffer);
 extern int ata_write_sectors(uint32_t lba, uint8_t sector_count, const void* buffer);
@@ -60,9 +64,26 @@ static uint32_t fat32_cluster_to_lba(uint32_t cluster) {
 int fs_init() {
     // Bilgileri sıfırla
     memset(&fs_info, 0, sizeof(fs_info_t));
+    
+    // Dosya yapıları için önbelleği oluştur
+    file_cache = kmem_cache_create("fs_file", sizeof(fs_file_t), 8, NULL);
     return FS_SUCCESS;
 }
 
+// Dosya yapısı tahsis et
+fs_file_t* fs_file_alloc() {
+    fs_file_t* file = (fs_file_t*)kmem_cache_alloc(file_cache);
+    if (file) {
+        memset(file, 0, sizeof(fs_file_t));
+    }
+    return file;
+}
+
+// Dosya yapısını serbest bırak
+void fs_file_free(fs_file_t* file) {
+    kmem_cache_free(file_cache, file);
+}
+
 // Dosya sistemini bağla
 int fs_mount(uint32_t device) {
     // Cihaz kimliğini ayarla
@@ -88,6 +88,10 @@ int fs_init();
 int fs_mount(uint32_t device);
 int fs_unmount();
 
+// Dosya yapısı tahsisi
+fs_file_t* fs_file_alloc();
+void fs_file_free(fs_file_t* file);
+
 // Dosya işlemleri
 int fs_open(const char* path, fs_file_t* file);
 int fs_close(fs_file_t* file);
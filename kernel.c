@@ -8,9 +8,16 @@
 #include "paging.h"
 #include "usermode.h"
 #include "pipe.h"
+#include "multiboot.h"
+#include "vma.h"
 #include "signals.h"
 #include "shell.h"
 #include "coreutils.h"
+#include "vdso.h"
+#include "ksm.h"
+#include "swap.h"
+#include "zram.h"
+#include "dma.h"
 
 // VGA terminali için sabitler
 #define VGA_WIDTH 80
@@ -383,7 +390,7 @@ void shell_process() {
 }
 
 // Kernel ana işlevi
-void kernel_main(void) {
+void kernel_main(uint32_t multiboot_magic, uint64_t multiboot_info) {
     // Terminali başlat
     terminal_initialize();
 
@@ -397,18 +404,27 @@ void kernel_main(void) {
     terminal_setcolor(vga_entry_color(VGA_COLOR_LIGHT_GREY, VGA_COLOR_BLACK));
     terminal_writestring("\nKernel modullerini baslatiyorum...\n");
     
-    // Bellek yönetimini başlat
-    memory_init();
-    terminal_writestring("Bellek yonetimi baslatildi.\n");
-    
     // IDT'yi başlat
     init_idt();
     terminal_writestring("Kesme tanimlama tablosu (IDT) baslatildi.\n");
     
+    // Önyükleyicinin bellek haritasını oku
+    static memory_map_entry_t mem_map[MULTIBOOT_MAX_MMAP_ENTRIES];
+    uint32_t mem_map_count = multiboot_read_memory_map(multiboot_magic, multiboot_info, mem_map, MULTIBOOT_MAX_MMAP_ENTRIES);
+    if (mem_map_count == 0) {
+        terminal_writestring("Uyari: Bellek haritasi alinamadi, 128 MB varsayiliyor.\n");
+        mem_map[0].start = 0x100000;
+        mem_map[0].size = 128 * 1024 * 1024;
+        mem_map[0].type = MMAP_TYPE_AVAILABLE;
+        mem_map_count = 1;
+    }
+    
     // Sayfalama sistemini başlat
-    // TODO: memory_map_entry_t yapısını doğru şekilde doldur
-    memory_map_entry_t mem_map[1] = {{0x100000, 128 * 1024 * 1024, 1}}; // 128 MB örnek bellek
-    paging_init(mem_map, 1);
+    paging_init(mem_map, mem_map_count);
+    
+    // Bellek yönetimini başlat (heap sayfaları sayfalama üzerinden eşlenir)
+    memory_init();
+    terminal_writestring("Bellek yonetimi baslatildi.\n");
     
     // GDT ve TSS'yi başlat
     gdt_init();
@@ -424,12 +440,28 @@ void kernel_main(void) {
     // Süreç yönetimini başlat
     init_processes();
     
+    // Sayfa hatası işleyicisini kaydet (isteğe bağlı sayfalama)
+    vma_init();
+    
+    // Kullanıcı süreçlerine eşlenecek vDSO sayfalarını hazırla
+    vdso_init(timer_get_frequency());
+    
     // Dosya sistemini başlat
     fs_init();
     
+    // Takas katmanları: önce sıkıştırılmış bellek, sığmayan sayfalar için disk bölümü
+    zram_init();
+    swap_init();
+    
+    // Sürücülerin fiziksel olarak kesintisiz tamponları için DMA havuzu
+    dma_init();
+    
     // Pipe sistemini ve sistem çağrılarını başlat
     init_syscalls();
     
+    // Aynı içerikli kullanıcı sayfalarını birleştiren tarayıcıyı başlat
+    ksm_init();
+    
     // Shell sürecini oluştur
     uint64_t shell_pid = create_process("shell", (uint64_t)shell_process, 0);
     if (shell_pid != 0) {
@@ -449,6 +481,12 @@ void kernel_main(void) {
         // Süreç zamanlayıcısını çağır
         schedule();
         
+        // Serbest bellek düşük eşiğin altındaysa sayfa geri kazan
+        paging_balance();
+        
+        // Boş zamanda sıfırlanmış sayfa havuzunu doldur
+        paging_refill_zero_pool();
+        
         // CPU'yu halt et (enerji tasarrufu)
         asm volatile("hlt");
     }
@@ -22,10 +22,24 @@ void* memset(void* dest, int val, size_t len);
 void memcpy(void* dest, const void* src, size_t n);
 void int_to_string(int num, char* str);
 
+// Kesmeleri kapat, önceki RFLAGS değerini döndür
+static inline uint64_t irq_save(void) {
+    uint64_t rflags;
+    asm volatile("pushfq; pop %0; cli" : "=r" (rflags) : : "memory");
+    return rflags;
+}
+
+// Kesmeler önceden açıksa tekrar aç
+static inline void irq_restore(uint64_t rflags) {
+    if (rflags & 0x200) {
+        asm volatile("sti" : : : "memory");
+    }
+}
+
 // Test fonksiyonları
 void test_process();
 
 // Kernel ana işlevi
-void kernel_main(void);
+void kernel_main(uint32_t multiboot_magic, uint64_t multiboot_info);
 
 #endif // KERNEL_H 
\ No newline at end of file
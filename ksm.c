@@ -0,0 +1,233 @@
+#include "kernel.h"
+#include "ksm.h"
+#include "process.h"
+#include "paging.h"
+#include "timer.h"
+#include "vma.h"
+#include "vdso.h"
+
+// Çerçevenin önceki taramadaki özeti (değişmeyen sayfalar aday olur)
+typedef struct {
+    uint64_t phys;
+    uint64_t checksum;
+} ksm_history_t;
+
+// Bu turda görülmüş, henüz eşi bulunmamış aday sayfa
+typedef struct {
+    uint64_t pass;               // Girişin eklendiği tur (eski turlar geçersiz)
+    uint64_t checksum;
+    void* pml4;
+    uint64_t addr;
+    void* phys;
+} ksm_unstable_t;
+
+// Birleştirilmiş çerçeve; tarayıcı bir referans tutar, içerik değişmez
+typedef struct {
+    void* phys;                  // NULL = boş
+    uint64_t checksum;
+} ksm_stable_t;
+
+static ksm_history_t ksm_history[KSM_HISTORY_SIZE];
+static ksm_unstable_t ksm_unstable[KSM_UNSTABLE_SIZE];
+static ksm_stable_t ksm_stable[KSM_STABLE_SIZE];
+
+// Tarama konumu: süreç yuvası ve o süreçteki adres
+static int scan_slot = 0;
+static uint64_t scan_pml4 = 0;
+static uint64_t scan_addr = 0;
+static uint64_t ksm_pass = 1;
+
+static ksm_info_t ksm_stats;
+
+// Sayfa içeriğinin özeti
+static uint64_t ksm_checksum(void* phys) {
+    uint64_t* words = (uint64_t*)phys_to_virt((uint64_t)phys);
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (uint64_t i = 0; i < PAGE_SIZE / sizeof(uint64_t); i++) {
+        hash = (hash ^ words[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+// Tarayıcının çerçeve referansını bırak
+static void ksm_stable_release(ksm_stable_t* stable) {
+    paging_page_put(stable->phys);
+    stable->phys = NULL;
+}
+
+// Tur sonu: kararsız tablo geçersiz olur, artık kimsenin kullanmadığı ortak çerçeveler bırakılır
+static void ksm_end_pass() {
+    ksm_pass++;
+    ksm_stats.full_scans++;
+
+    for (int i = 0; i < KSM_STABLE_SIZE; i++) {
+        if (ksm_stable[i].phys && paging_page_refcount(ksm_stable[i].phys) <= 1) {
+            ksm_stable_release(&ksm_stable[i]);
+        }
+    }
+}
+
+// Bölge birleştirilebilir mi? (paylaşılan bellek ve vDSO sayfaları hariç)
+static int ksm_vma_mergeable(vm_area_t* vma) {
+    if (vma->shm || !(vma->flags & (VMA_READ | VMA_EXEC))) {
+        return 0;
+    }
+    return vma->end <= VDSO_BASE || vma->start >= VDSO_END;
+}
+
+// Tek bir kullanıcı sayfasını tara
+static void ksm_scan_page(void* pml4, uint64_t addr) {
+    void* phys = paging_user_private_frame(pml4, (void*)addr);
+    if (!phys) {
+        return;
+    }
+    ksm_stats.pages_scanned++;
+
+    // Son taramadan beri değişen sayfalar sık yazılıyordur, birleştirilmez
+    uint64_t checksum = ksm_checksum(phys);
+    ksm_history_t* history = &ksm_history[((uint64_t)phys / PAGE_SIZE) % KSM_HISTORY_SIZE];
+    if (history->phys != (uint64_t)phys || history->checksum != checksum) {
+        history->phys = (uint64_t)phys;
+        history->checksum = checksum;
+        return;
+    }
+
+    // Aynı içerikli ortak çerçeve varsa ona yönlendir (içerik tam karşılaştırılır)
+    ksm_stable_t* stable = &ksm_stable[checksum % KSM_STABLE_SIZE];
+    if (stable->phys) {
+        if (stable->checksum == checksum && paging_merge_user_page(pml4, (void*)addr, phys, stable->phys)) {
+            ksm_stats.pages_merged++;
+        }
+        return;
+    }
+
+    // Bu turda aynı özetli başka sayfa görüldüyse ikisi yeni ortak çerçevede birleşir
+    ksm_unstable_t* unstable = &ksm_unstable[checksum % KSM_UNSTABLE_SIZE];
+    if (unstable->pass == ksm_pass && unstable->checksum == checksum && unstable->phys != phys) {
+        // Eş önce dondurulur; içeriği artık değişemez
+        if (paging_merge_user_page(unstable->pml4, (void*)unstable->addr, unstable->phys, unstable->phys)) {
+            paging_page_get(unstable->phys);
+            stable->phys = unstable->phys;
+            stable->checksum = checksum;
+            unstable->pass = 0;
+
+            if (paging_merge_user_page(pml4, (void*)addr, phys, stable->phys)) {
+                ksm_stats.pages_merged++;
+                return;
+            }
+
+            // İçerik farklı çıktı; donan sayfa ilk yazmada yerinde açılır
+            ksm_stable_release(stable);
+        }
+    }
+
+    unstable->pass = ksm_pass;
+    unstable->checksum = checksum;
+    unstable->pml4 = pml4;
+    unstable->addr = addr;
+    unstable->phys = phys;
+}
+
+// Sonraki süreç yuvasına geç; tablo bitince tur tamamlanır
+static void ksm_next_slot() {
+    scan_pml4 = 0;
+    scan_addr = 0;
+    if (++scan_slot >= MAX_PROCESSES) {
+        scan_slot = 0;
+        ksm_end_pass();
+    }
+}
+
+// Sıradaki en fazla budget sayfayı tara
+// Bölge listeleri, referans sayıları ve fiziksel ayırıcı kesme bağlamında da değişir;
+// her adım kesmeler kapalıyken yapılır, kesmeler yalnız sayfalar arasında açılır
+static void ksm_scan(uint32_t budget) {
+    // Hiç kullanıcı sayfası yoksa tur başına bir kez döner
+    for (int slots = 0; budget > 0 && slots <= MAX_PROCESSES; ) {
+        uint64_t rflags = irq_save();
+        process_t* process = get_process_slot(scan_slot);
+        uint64_t pml4 = process ? process->page_directory : 0;
+        vm_area_t* vma = NULL;
+        if (pml4) {
+            // Yeni program yüklendiyse süreç baştan taranır
+            if (pml4 != scan_pml4) {
+                scan_pml4 = pml4;
+                scan_addr = 0;
+            }
+            for (vma = process->vmas.head; vma; vma = vma->next) {
+                if (vma->end > scan_addr && ksm_vma_mergeable(vma)) {
+                    break;
+                }
+            }
+        }
+        uint64_t start = vma ? vma->start : 0;
+        uint64_t end = vma ? vma->end : 0;
+
+        if (!vma) {
+            ksm_next_slot();
+            irq_restore(rflags);
+            slots++;
+            continue;
+        }
+        irq_restore(rflags);
+
+        if (scan_addr < start) {
+            scan_addr = start;
+        }
+        for (; scan_addr < end && budget > 0; scan_addr += PAGE_SIZE, budget--) {
+            // Süreç sayfalar arasında çıkmış ya da yeni program yüklemiş olabilir;
+            // adres alanı değiştiyse tablolar yürünmez, konum baştan okunur
+            rflags = irq_save();
+            process = get_process_slot(scan_slot);
+            if (!process || process->page_directory != pml4) {
+                irq_restore(rflags);
+                break;
+            }
+            ksm_scan_page((void*)pml4, scan_addr);
+            irq_restore(rflags);
+        }
+    }
+}
+
+// Arka plan tarayıcı süreci
+static void ksm_thread() {
+    while (1) {
+        ksm_scan(KSM_PAGES_PER_SCAN);
+        process_sleep(KSM_SLEEP_MS);
+    }
+}
+
+// Sayfa birleştirme tarayıcısını başlat
+void ksm_init() {
+    memset(ksm_history, 0, sizeof(ksm_history));
+    memset(ksm_unstable, 0, sizeof(ksm_unstable));
+    memset(ksm_stable, 0, sizeof(ksm_stable));
+    memset(&ksm_stats, 0, sizeof(ksm_stats));
+
+    uint64_t pid = create_process("ksmd", (uint64_t)ksm_thread, 0);
+    if (pid == 0) {
+        terminal_writestring("Hata: Sayfa birlestirme sureci olusturulamadi!\n");
+        return;
+    }
+    terminal_writestring("Sayfa birlestirme tarayicisi baslatildi.\n");
+}
+
+// İstatistikleri al; ortak çerçeve sayıları anlık hesaplanır
+void ksm_get_info(ksm_info_t* info) {
+    *info = ksm_stats;
+    info->pages_shared = 0;
+    info->pages_sharing = 0;
+
+    for (int i = 0; i < KSM_STABLE_SIZE; i++) {
+        if (!ksm_stable[i].phys) {
+            continue;
+        }
+
+        // Referanslardan biri tarayıcının, biri ilk kullanıcının
+        uint32_t refs = paging_page_refcount(ksm_stable[i].phys);
+        if (refs >= 2) {
+            info->pages_shared++;
+            info->pages_sharing += refs - 2;
+        }
+    }
+}
\ No newline at end of file
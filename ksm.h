@@ -0,0 +1,28 @@
+#ifndef KSM_H
+#define KSM_H
+
+#include <stdint.h>
+
+// Tarayıcı ayarları
+#define KSM_PAGES_PER_SCAN 128   // Her uyanışta taranan en fazla sayfa
+#define KSM_SLEEP_MS       200   // Taramalar arası bekleme (ms)
+
+// Tablo boyutları (doğrudan eşlemeli, çakışan eski girişin yerine geçer)
+#define KSM_HISTORY_SIZE   1024  // Çerçeve başına son özet
+#define KSM_UNSTABLE_SIZE  256   // Bu turda görülen adaylar
+#define KSM_STABLE_SIZE    256   // Birleştirilmiş salt okunur çerçeveler
+
+// Sayfa birleştirme istatistikleri
+typedef struct {
+    uint64_t full_scans;         // Tamamlanan tarama turu
+    uint64_t pages_scanned;      // Taranan aday sayfa
+    uint64_t pages_merged;       // Ortak çerçeveye yönlendirilen sayfa (toplam)
+    uint64_t pages_shared;       // Kullanımdaki ortak çerçeve
+    uint64_t pages_sharing;      // Ortak çerçevelerin kazandırdığı sayfa
+} ksm_info_t;
+
+// Aynı içerikli kullanıcı sayfalarını birleştirme
+void ksm_init();
+void ksm_get_info(ksm_info_t* info);
+
+#endif // KSM_H
\ No newline at end of file
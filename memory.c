@@ -1,31 +1,257 @@
 #include "kernel.h"
+#include "paging.h"
 
-// Basit bellek yönetim sistemi
-// Bu gerçek bir kernel için oldukça basittir
+// Ayrık boyut sınıflı (segregated fit) bellek yönetimi
+// Her boyut aralığı için ayrı serbest liste tutulur, uygun liste bitmap
+// üzerinden O(1) bulunur. Blok başlık/sonlukları (boundary tag) sayesinde
+// kfree sadece fiziksel komşularıyla birleştirme yapar.
+//
+// Heap, KERNEL_HEAP_START'tan başlayan kendi sanal bölgesindedir; yer
+// kalmadığında sonuna yeni sayfalar eşlenir, sonda büyük boş alan
+// oluştuğunda sayfalar geri verilir.
 
-#define MEMORY_START 0x100000 // 1MB başlangıç
-#define MEMORY_SIZE  0x100000 // 1MB bellek alanı
-#define BLOCK_SIZE   4096     // 4KB blok boyutu
+#define HEAP_INITIAL_PAGES    16           // Başlangıç boyutu (64 KB)
+#define HEAP_GROW_MIN_PAGES   16           // Tek seferde en az 64 KB büyü
+#define HEAP_SHRINK_THRESHOLD (256 * 1024) // Sonda bu kadar boş alan olunca küçül
+#define HEAP_HUGE_GROW_PAGES  256          // Bundan büyük büyümeler 2 MB sınırına uzatılır
 
+// Hizalama ve blok sınırları
+#define ALIGNMENT        8
+#define BLOCK_HEADER     sizeof(size_t)                  // Boyut + durum bitleri
+#define BLOCK_MIN_SIZE   (sizeof(memory_block_t) + sizeof(size_t)) // Başlık + bağlar + sonluk
+
+// Başlıktaki durum bitleri (boyut 8'in katı olduğu için alt 3 bit boş)
+#define BLOCK_FREE       0x1  // Blok serbest
+#define BLOCK_PREV_FREE  0x2  // Fiziksel olarak önceki blok serbest
+#define BLOCK_FLAGS      0x7
+
+// Boyut sınıfları: her ikinin kuvveti aralığı SL_COUNT alt sınıfa bölünür
+#define SL_LOG2          3
+#define SL_COUNT         (1 << SL_LOG2)          // Aralık başına 8 alt sınıf
+#define FL_SHIFT         (SL_LOG2 + 3)           // Küçük blok sınırı: 64 bayt
+#define SMALL_BLOCK      (1 << FL_SHIFT)
+#define FL_COUNT         26                      // 2 GB'a kadar bloklar
+
+// Blok yapısı; bağlar sadece blok serbestken anlamlıdır (kullanımda yük alanına aittir)
 typedef struct memory_block {
-    size_t size;
-    uint8_t is_free;
-    struct memory_block* next;
+    size_t size;                      // Toplam blok boyutu (başlık dahil) | durum bitleri
+    struct memory_block* next_free;   // Aynı sınıftaki sonraki serbest blok
+    struct memory_block* prev_free;   // Aynı sınıftaki önceki serbest blok
 } memory_block_t;
 
 static memory_block_t* memory_start = NULL;
+static uint64_t heap_end = 0;      // Eşlenmiş heap alanının sonu
 static uint8_t memory_initialized = 0;
 
+// Serbest liste başları ve boşluk bitmap'leri
+static memory_block_t* free_lists[FL_COUNT][SL_COUNT];
+static uint32_t fl_bitmap;
+static uint32_t sl_bitmap[FL_COUNT];
+
+// Blok yardımcıları
+static inline size_t block_size(memory_block_t* block) {
+    return block->size & ~(size_t)BLOCK_FLAGS;
+}
+
+static inline memory_block_t* block_next(memory_block_t* block) {
+    return (memory_block_t*)((uint64_t)block + block_size(block));
+}
+
+static inline memory_block_t* block_prev(memory_block_t* block) {
+    // Önceki serbest bloğun sonluğu hemen bu başlığın önündedir
+    size_t prev_size = *(size_t*)((uint64_t)block - sizeof(size_t));
+    return (memory_block_t*)((uint64_t)block - prev_size);
+}
+
+static inline void block_set_footer(memory_block_t* block) {
+    *(size_t*)((uint64_t)block + block_size(block) - sizeof(size_t)) = block_size(block);
+}
+
+// En yüksek set bitin indeksi
+static inline int fls64(size_t value) {
+    return 63 - __builtin_clzll(value);
+}
+
+// Boyutu (birinci seviye, ikinci seviye) sınıf indeksine çevir
+static void mapping_insert(size_t size, int* fl, int* sl) {
+    if (size < SMALL_BLOCK) {
+        *fl = 0;
+        *sl = size / (SMALL_BLOCK / SL_COUNT);
+    } else {
+        int f = fls64(size);
+        *sl = (int)(size >> (f - SL_LOG2)) ^ SL_COUNT;
+        *fl = f - FL_SHIFT + 1;
+    }
+}
+
+// Arama için boyutu bir sonraki sınıf sınırına yuvarla
+// (bulunan sınıftaki her blok isteği karşılar)
+static void mapping_search(size_t size, int* fl, int* sl) {
+    if (size >= SMALL_BLOCK) {
+        size += ((size_t)1 << (fls64(size) - SL_LOG2)) - 1;
+    }
+    mapping_insert(size, fl, sl);
+}
+
+// Serbest bloğu sınıf listesine ekle
+static void free_list_insert(memory_block_t* block) {
+    int fl, sl;
+    mapping_insert(block_size(block), &fl, &sl);
+
+    block->prev_free = NULL;
+    block->next_free = free_lists[fl][sl];
+    if (block->next_free) {
+        block->next_free->prev_free = block;
+    }
+    free_lists[fl][sl] = block;
+
+    fl_bitmap |= 1U << fl;
+    sl_bitmap[fl] |= 1U << sl;
+}
+
+// Serbest bloğu sınıf listesinden çıkar
+static void free_list_remove(memory_block_t* block) {
+    int fl, sl;
+    mapping_insert(block_size(block), &fl, &sl);
+
+    if (block->prev_free) {
+        block->prev_free->next_free = block->next_free;
+    } else {
+        free_lists[fl][sl] = block->next_free;
+    }
+    if (block->next_free) {
+        block->next_free->prev_free = block->prev_free;
+    }
+
+    // Liste boşaldıysa bitmap bitlerini temizle
+    if (!free_lists[fl][sl]) {
+        sl_bitmap[fl] &= ~(1U << sl);
+        if (!sl_bitmap[fl]) {
+            fl_bitmap &= ~(1U << fl);
+        }
+    }
+}
+
+// İsteği karşılayan ilk boş olmayan sınıfı bitmap'lerden bul
+static memory_block_t* free_list_find(size_t size) {
+    int fl, sl;
+    mapping_search(size, &fl, &sl);
+    if (fl >= FL_COUNT) {
+        return NULL;
+    }
+
+    // Aynı birinci seviyede daha büyük alt sınıf
+    uint32_t sl_map = sl_bitmap[fl] & (~0U << sl);
+    if (!sl_map) {
+        // Daha büyük birinci seviye
+        uint32_t fl_map = (fl + 1 < 32) ? (fl_bitmap & (~0U << (fl + 1))) : 0;
+        if (!fl_map) {
+            return NULL;
+        }
+        fl = __builtin_ctz(fl_map);
+        sl_map = sl_bitmap[fl];
+    }
+    sl = __builtin_ctz(sl_map);
+
+    return free_lists[fl][sl];
+}
+
+// Heap'i sonuna yeni sayfalar eşleyerek büyüt
+static int heap_grow(size_t size) {
+    // Sınıf yuvarlaması sonrası da sığması için pay bırak
+    size_t needed = size + (size >> SL_LOG2) + BLOCK_HEADER;
+    uint64_t pages = (needed + PAGE_SIZE - 1) / PAGE_SIZE;
+    if (pages < HEAP_GROW_MIN_PAGES) {
+        pages = HEAP_GROW_MIN_PAGES;
+    }
+
+    // Büyük büyümelerde sonu 2 MB'a hizala; hizalı kısımlar büyük sayfayla eşlenir
+    if (pages >= HEAP_HUGE_GROW_PAGES) {
+        uint64_t new_end = (heap_end + pages * PAGE_SIZE + PAGE_SIZE_2M - 1) & ~(PAGE_SIZE_2M - 1);
+        pages = (new_end - heap_end) / PAGE_SIZE;
+    }
+
+    if (heap_end + pages * PAGE_SIZE > KERNEL_HEAP_END) {
+        return 0;
+    }
+
+    if (!kmalloc_pages_at((void*)heap_end, pages, PAGE_ALLOC_ANY)) {
+        return 0;
+    }
+
+    // Eski bitiş başlığı yeni serbest bloğun başlığı olur
+    memory_block_t* block = (memory_block_t*)(heap_end - BLOCK_HEADER);
+    size_t size_total = pages * PAGE_SIZE;
+    size_t prev_free = block->size & BLOCK_PREV_FREE;
+
+    // Sondaki serbest blokla birleştir
+    if (prev_free) {
+        memory_block_t* prev = block_prev(block);
+        free_list_remove(prev);
+        size_total += block_size(prev);
+        block = prev;
+        prev_free = block->size & BLOCK_PREV_FREE;
+    }
+
+    heap_end += pages * PAGE_SIZE;
+
+    block->size = size_total | BLOCK_FREE | prev_free;
+    block_set_footer(block);
+    block_next(block)->size = BLOCK_PREV_FREE; // Yeni bitiş başlığı
+
+    free_list_insert(block);
+    return 1;
+}
+
+// Heap sonundaki serbest bloğun fazla sayfalarını geri ver
+// (blok henüz serbest listeye eklenmemiş olmalı)
+static void heap_shrink(memory_block_t* block) {
+    // Blokta en az bir minimum blok kadar yer kalsın
+    uint64_t new_end = ((uint64_t)block + BLOCK_MIN_SIZE + BLOCK_HEADER + PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1);
+    uint64_t min_end = KERNEL_HEAP_START + HEAP_INITIAL_PAGES * PAGE_SIZE;
+    if (new_end < min_end) {
+        new_end = min_end;
+    }
+
+    if (new_end >= heap_end || heap_end - new_end < HEAP_SHRINK_THRESHOLD) {
+        return;
+    }
+
+    // Bloğu yeni sona göre kısalt
+    block->size = (new_end - BLOCK_HEADER - (uint64_t)block) | (block->size & BLOCK_FLAGS);
+    block_set_footer(block);
+    block_next(block)->size = BLOCK_PREV_FREE; // Yeni bitiş başlığı
+
+    kfree_pages((void*)new_end, (heap_end - new_end) / PAGE_SIZE);
+    heap_end = new_end;
+}
+
 // Bellek yönetimini başlat
 void memory_init(void) {
     if (memory_initialized) return;
-    
-    // İlk blok
-    memory_start = (memory_block_t*)MEMORY_START;
-    memory_start->size = MEMORY_SIZE - sizeof(memory_block_t);
-    memory_start->is_free = 1;
-    memory_start->next = NULL;
-    
+
+    memset(free_lists, 0, sizeof(free_lists));
+    memset(sl_bitmap, 0, sizeof(sl_bitmap));
+    fl_bitmap = 0;
+
+    // Başlangıç sayfalarını heap bölgesine eşle
+    if (!kmalloc_pages_at((void*)KERNEL_HEAP_START, HEAP_INITIAL_PAGES, PAGE_ALLOC_ANY)) {
+        terminal_writestring("Hata: Kernel heap eslenemedi!\n");
+        return;
+    }
+    heap_end = KERNEL_HEAP_START + HEAP_INITIAL_PAGES * PAGE_SIZE;
+
+    // İlk blok: tüm alan, sonunda sıfır boyutlu kullanımda bir bitiş başlığı
+    memory_start = (memory_block_t*)KERNEL_HEAP_START;
+    memory_start->size = (heap_end - KERNEL_HEAP_START - BLOCK_HEADER) | BLOCK_FREE;
+    block_set_footer(memory_start);
+
+    // Bitiş başlığı ileri birleştirmeyi durdurur
+    memory_block_t* epilogue = block_next(memory_start);
+    epilogue->size = BLOCK_PREV_FREE;
+
+    free_list_insert(memory_start);
+
     memory_initialized = 1;
 }
 
@@ -33,44 +259,51 @@ void memory_init(void) {
 void* kmalloc(size_t size) {
     if (!memory_initialized) {
         memory_init();
+        if (!memory_initialized) {
+            return NULL;
+        }
     }
-    
+
     if (size == 0) {
         return NULL;
     }
-    
-    // 8 byte'a hizala
-    if (size % 8 != 0) {
-        size = size + (8 - (size % 8));
-    }
-    
-    memory_block_t* current = memory_start;
-    
-    // Uygun blok bul
-    while (current != NULL) {
-        if (current->is_free && current->size >= size) {
-            // Blok yeterince büyük mü?
-            if (current->size > size + sizeof(memory_block_t) + BLOCK_SIZE) {
-                // Yeni blok oluştur
-                memory_block_t* new_block = (memory_block_t*)((uint64_t)current + sizeof(memory_block_t) + size);
-                new_block->size = current->size - size - sizeof(memory_block_t);
-                new_block->is_free = 1;
-                new_block->next = current->next;
-                
-                // Mevcut bloğu ayarla
-                current->size = size;
-                current->next = new_block;
-            }
-            
-            current->is_free = 0;
-            return (void*)((uint64_t)current + sizeof(memory_block_t));
+
+    // 8 byte'a hizala ve başlık ekle
+    if (size % ALIGNMENT != 0) {
+        size = size + (ALIGNMENT - (size % ALIGNMENT));
+    }
+    size += BLOCK_HEADER;
+    if (size < BLOCK_MIN_SIZE) {
+        size = BLOCK_MIN_SIZE;
+    }
+
+    // Uygun blok bul, yoksa heap'i büyütüp tekrar dene
+    memory_block_t* block = free_list_find(size);
+    if (!block) {
+        if (!heap_grow(size) || !(block = free_list_find(size))) {
+            // Yeterli bellek yok
+            return NULL;
         }
-        
-        current = current->next;
     }
-    
-    // Yeterli bellek yok
-    return NULL;
+    free_list_remove(block);
+
+    size_t total = block_size(block);
+
+    // Artan kısım ayrı bir blok olacak kadar büyükse böl
+    if (total - size >= BLOCK_MIN_SIZE) {
+        memory_block_t* rest = (memory_block_t*)((uint64_t)block + size);
+        rest->size = (total - size) | BLOCK_FREE;
+        block_set_footer(rest);
+        free_list_insert(rest);
+
+        // Önceki blok serbest olamaz (birleştirilmiş olurdu)
+        block->size = size;
+    } else {
+        block->size = total;
+        block_next(block)->size &= ~(size_t)BLOCK_PREV_FREE;
+    }
+
+    return (void*)((uint64_t)block + BLOCK_HEADER);
 }
 
 // Bellek bloğunu serbest bırak
@@ -78,22 +311,42 @@ void kfree(void* ptr) {
     if (ptr == NULL || !memory_initialized) {
         return;
     }
-    
-    memory_block_t* block = (memory_block_t*)((uint64_t)ptr - sizeof(memory_block_t));
-    
-    // Blok serbest olarak işaretle
-    block->is_free = 1;
-    
-    // Ardışık boş blokları birleştir
-    memory_block_t* current = memory_start;
-    
-    while (current != NULL && current->next != NULL) {
-        if (current->is_free && current->next->is_free) {
-            // Blokları birleştir
-            current->size = current->size + sizeof(memory_block_t) + current->next->size;
-            current->next = current->next->next;
-        } else {
-            current = current->next;
-        }
+
+    memory_block_t* block = (memory_block_t*)((uint64_t)ptr - BLOCK_HEADER);
+
+    if (block->size & BLOCK_FREE) {
+        terminal_writestring("Hata: Zaten serbest olan blok serbest birakilmaya calisiliyor!\n");
+        return;
+    }
+
+    size_t size = block_size(block);
+    size_t prev_free = block->size & BLOCK_PREV_FREE;
+
+    // Sonraki fiziksel komşu ile birleştir
+    memory_block_t* next = block_next(block);
+    if (next->size & BLOCK_FREE) {
+        free_list_remove(next);
+        size += block_size(next);
     }
-} 
\ No newline at end of file
+
+    // Önceki fiziksel komşu ile birleştir
+    if (prev_free) {
+        memory_block_t* prev = block_prev(block);
+        free_list_remove(prev);
+        size += block_size(prev);
+        block = prev;
+        prev_free = block->size & BLOCK_PREV_FREE;
+    }
+
+    // Birleşik bloğu serbest olarak işaretle
+    block->size = size | BLOCK_FREE | prev_free;
+    block_set_footer(block);
+    block_next(block)->size |= BLOCK_PREV_FREE;
+
+    // Heap'in sonundaysa fazla sayfaları sisteme geri ver
+    if ((uint64_t)block_next(block) == heap_end - BLOCK_HEADER) {
+        heap_shrink(block);
+    }
+
+    free_list_insert(block);
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "kernel.h"
+#include "multiboot.h"
+
+// Haritaya bir girdi ekle
+static uint32_t mmap_add(memory_map_entry_t* entries, uint32_t count, uint32_t max_entries,
+                         uint64_t start, uint64_t size, uint32_t type) {
+    if (count >= max_entries || size == 0) {
+        return count;
+    }
+
+    entries[count].start = start;
+    entries[count].size = size;
+    entries[count].type = type;
+    return count + 1;
+}
+
+// Haritası olmayan önyükleyiciler için alt/üst bellek boyutlarından harita oluştur
+static uint32_t mmap_from_meminfo(memory_map_entry_t* entries, uint32_t max_entries,
+                                  uint32_t mem_lower, uint32_t mem_upper) {
+    uint32_t count = 0;
+    count = mmap_add(entries, count, max_entries, 0, (uint64_t)mem_lower * 1024, MMAP_TYPE_AVAILABLE);
+    count = mmap_add(entries, count, max_entries, 0x100000, (uint64_t)mem_upper * 1024, MMAP_TYPE_AVAILABLE);
+    return count;
+}
+
+// Multiboot bilgi yapısını oku
+static uint32_t multiboot1_read(multiboot_info_t* info, memory_map_entry_t* entries, uint32_t max_entries) {
+    uint32_t count = 0;
+
+    if (info->flags & MULTIBOOT_INFO_MEM_MAP) {
+        uint64_t addr = info->mmap_addr;
+        uint64_t end = addr + info->mmap_length;
+
+        while (addr + sizeof(multiboot_mmap_entry_t) <= end) {
+            multiboot_mmap_entry_t* entry = (multiboot_mmap_entry_t*)addr;
+
+            // Bozuk boyut döngüyü ilerletmez ya da girdi alanları dışarı taşar
+            if (entry->size < sizeof(multiboot_mmap_entry_t) - sizeof(entry->size)) {
+                break;
+            }
+            count = mmap_add(entries, count, max_entries, entry->addr, entry->len, entry->type);
+
+            // size alanı kendisini saymaz
+            addr += entry->size + sizeof(entry->size);
+        }
+
+        return count;
+    }
+
+    if (info->flags & MULTIBOOT_INFO_MEMORY) {
+        return mmap_from_meminfo(entries, max_entries, info->mem_lower, info->mem_upper);
+    }
+
+    return 0;
+}
+
+// Multiboot2 etiket listesini oku
+static uint32_t multiboot2_read(uint64_t info_addr, memory_map_entry_t* entries, uint32_t max_entries) {
+    uint32_t total_size = *(uint32_t*)info_addr;
+    uint64_t end = info_addr + total_size;
+    multiboot2_tag_basic_meminfo_t* meminfo = NULL;
+
+    // İlk etiket 8 baytlık başlıktan sonra gelir
+    uint64_t addr = info_addr + 8;
+    while (addr + sizeof(multiboot2_tag_t) <= end) {
+        multiboot2_tag_t* tag = (multiboot2_tag_t*)addr;
+        if (tag->type == MULTIBOOT2_TAG_END || tag->size < sizeof(multiboot2_tag_t) || addr + tag->size > end) {
+            break;
+        }
+
+        // Girdi boyutu bozuk harita atlanır (0 ise döngü ilerlemez)
+        multiboot2_tag_mmap_t* mmap = (multiboot2_tag_mmap_t*)tag;
+        if (tag->type == MULTIBOOT2_TAG_MMAP && mmap->entry_size >= sizeof(multiboot2_mmap_entry_t)) {
+            uint32_t count = 0;
+
+            for (uint64_t e = addr + sizeof(multiboot2_tag_mmap_t); e + mmap->entry_size <= addr + tag->size; e += mmap->entry_size) {
+                multiboot2_mmap_entry_t* entry = (multiboot2_mmap_entry_t*)e;
+                count = mmap_add(entries, count, max_entries, entry->addr, entry->len, entry->type);
+            }
+
+            return count;
+        }
+
+        if (tag->type == MULTIBOOT2_TAG_BASIC_MEMINFO && tag->size >= sizeof(multiboot2_tag_basic_meminfo_t)) {
+            meminfo = (multiboot2_tag_basic_meminfo_t*)tag;
+        }
+
+        // Sonraki etiket 8 bayt hizalı
+        addr += (tag->size + 7) & ~7;
+    }
+
+    if (meminfo) {
+        return mmap_from_meminfo(entries, max_entries, meminfo->mem_lower, meminfo->mem_upper);
+    }
+
+    return 0;
+}
+
+// Önyükleyici bilgisinden bellek haritasını oku
+uint32_t multiboot_read_memory_map(uint32_t magic, uint64_t info_addr, memory_map_entry_t* entries, uint32_t max_entries) {
+    if (info_addr == 0) {
+        return 0;
+    }
+
+    if (magic == MULTIBOOT_BOOTLOADER_MAGIC) {
+        return multiboot1_read((multiboot_info_t*)info_addr, entries, max_entries);
+    }
+
+    if (magic == MULTIBOOT2_BOOTLOADER_MAGIC) {
+        return multiboot2_read(info_addr, entries, max_entries);
+    }
+
+    terminal_writestring("Hata: Bilinmeyen multiboot sihirli sayisi!\n");
+    return 0;
+}
\ No newline at end of file
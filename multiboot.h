@@ -0,0 +1,78 @@
+#ifndef MULTIBOOT_H
+#define MULTIBOOT_H
+
+#include <stdint.h>
+#include "paging.h"
+
+// Önyükleyicinin EAX'te bıraktığı sihirli sayılar
+#define MULTIBOOT_BOOTLOADER_MAGIC  0x2BADB002
+#define MULTIBOOT2_BOOTLOADER_MAGIC 0x36D76289
+
+// Okunacak en fazla bellek haritası girdisi
+#define MULTIBOOT_MAX_MMAP_ENTRIES 64
+
+// Multiboot bilgi yapısı bayrakları
+#define MULTIBOOT_INFO_MEMORY  0x1   // mem_lower/mem_upper geçerli
+#define MULTIBOOT_INFO_MEM_MAP 0x40  // mmap_addr/mmap_length geçerli
+
+// Multiboot bilgi yapısı (sadece kullanılan alanlar)
+typedef struct {
+    uint32_t flags;
+    uint32_t mem_lower;          // 1 MB altındaki bellek (KB)
+    uint32_t mem_upper;          // 1 MB üstündeki bellek (KB)
+    uint32_t boot_device;
+    uint32_t cmdline;
+    uint32_t mods_count;
+    uint32_t mods_addr;
+    uint32_t syms[4];
+    uint32_t mmap_length;        // Bellek haritası uzunluğu (bayt)
+    uint32_t mmap_addr;          // Bellek haritası adresi
+} __attribute__((packed)) multiboot_info_t;
+
+// Multiboot bellek haritası girdisi
+typedef struct {
+    uint32_t size;               // Bu alan hariç girdi boyutu
+    uint64_t addr;
+    uint64_t len;
+    uint32_t type;
+} __attribute__((packed)) multiboot_mmap_entry_t;
+
+// Multiboot2 etiket türleri
+#define MULTIBOOT2_TAG_END           0
+#define MULTIBOOT2_TAG_BASIC_MEMINFO 4
+#define MULTIBOOT2_TAG_MMAP          6
+
+// Multiboot2 etiket başlığı (etiketler 8 bayt hizalıdır)
+typedef struct {
+    uint32_t type;
+    uint32_t size;
+} multiboot2_tag_t;
+
+// Multiboot2 temel bellek bilgisi etiketi
+typedef struct {
+    uint32_t type;
+    uint32_t size;
+    uint32_t mem_lower;
+    uint32_t mem_upper;
+} multiboot2_tag_basic_meminfo_t;
+
+// Multiboot2 bellek haritası etiketi
+typedef struct {
+    uint32_t type;
+    uint32_t size;
+    uint32_t entry_size;
+    uint32_t entry_version;
+} multiboot2_tag_mmap_t;
+
+// Multiboot2 bellek haritası girdisi
+typedef struct {
+    uint64_t addr;
+    uint64_t len;
+    uint32_t type;
+    uint32_t reserved;
+} multiboot2_mmap_entry_t;
+
+// Önyükleyici bilgisinden bellek haritasını oku, girdi sayısını döndür (0 = yok)
+uint32_t multiboot_read_memory_map(uint32_t magic, uint64_t info_addr, memory_map_entry_t* entries, uint32_t max_entries);
+
+#endif // MULTIBOOT_H
\ No newline at end of file
@@ -0,0 +1,229 @@
+#include "kernel.h"
+#include "numa.h"
+#include "paging.h"
+
+static numa_info_t numa;
+
+// Doğrudan eşlemenin kapsadığı sınır; ötesindeki tablolar okunmaz
+static uint64_t numa_phys_limit = 0;
+
+// İmza karşılaştır (n bayt)
+static int acpi_signature_is(const char* data, const char* signature, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        if (data[i] != signature[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Baytların toplamı 0 mı?
+static int acpi_checksum_ok(const void* data, uint32_t length) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint8_t sum = 0;
+    for (uint32_t i = 0; i < length; i++) {
+        sum += bytes[i];
+    }
+    return sum == 0;
+}
+
+// Fiziksel adresteki tabloyu doğrudan eşleme üzerinden eriş (eşlenmemiş ya da bozuksa NULL)
+static acpi_header_t* acpi_table_at(uint64_t phys) {
+    if (phys == 0 || phys + sizeof(acpi_header_t) > numa_phys_limit) {
+        return NULL;
+    }
+
+    acpi_header_t* header = (acpi_header_t*)phys_to_virt(phys);
+    if (header->length < sizeof(acpi_header_t) || phys + header->length > numa_phys_limit ||
+        !acpi_checksum_ok(header, header->length)) {
+        return NULL;
+    }
+    return header;
+}
+
+// RSDP'yi 16 bayt sınırlarında ara
+static acpi_rsdp_t* acpi_scan_rsdp(uint64_t start, uint64_t end) {
+    for (uint64_t phys = start; phys + sizeof(acpi_rsdp_t) <= end; phys += 16) {
+        acpi_rsdp_t* rsdp = (acpi_rsdp_t*)phys_to_virt(phys);
+        if (acpi_signature_is(rsdp->signature, "RSD PTR ", 8) && acpi_checksum_ok(rsdp, 20)) {
+            return rsdp;
+        }
+    }
+    return NULL;
+}
+
+// RSDT/XSDT'de imzası verilen tabloyu bul
+static acpi_header_t* acpi_find_table(const char* signature) {
+    // Önce EBDA'nın ilk 1 KB'ı, sonra BIOS salt okunur alanı
+    uint64_t ebda = (uint64_t)*(uint16_t*)phys_to_virt(ACPI_EBDA_POINTER) << 4;
+    acpi_rsdp_t* rsdp = NULL;
+    if (ebda >= 0x80000 && ebda < ACPI_BIOS_START) {
+        rsdp = acpi_scan_rsdp(ebda, ebda + 1024);
+    }
+    if (!rsdp) {
+        rsdp = acpi_scan_rsdp(ACPI_BIOS_START, ACPI_BIOS_END);
+    }
+    if (!rsdp) {
+        return NULL;
+    }
+
+    // ACPI 2.0 ve sonrası 64 bit girdili XSDT'yi kullanır
+    acpi_header_t* root = NULL;
+    uint32_t entry_size = 4;
+    if (rsdp->revision >= 2 && rsdp->xsdt_address) {
+        root = acpi_table_at(rsdp->xsdt_address);
+        entry_size = 8;
+    }
+    if (!root) {
+        root = acpi_table_at(rsdp->rsdt_address);
+        entry_size = 4;
+    }
+    if (!root) {
+        return NULL;
+    }
+
+    uint8_t* entries = (uint8_t*)root + sizeof(acpi_header_t);
+    uint32_t count = (root->length - sizeof(acpi_header_t)) / entry_size;
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t phys = entry_size == 8 ? *(uint64_t*)(entries + i * 8) : *(uint32_t*)(entries + i * 4);
+        acpi_header_t* table = acpi_table_at(phys);
+        if (table && acpi_signature_is(table->signature, signature, 4)) {
+            return table;
+        }
+    }
+    return NULL;
+}
+
+// Yakınlık alanının düğüm numarası; yeni alan için düğüm açar (yer yoksa -1)
+static int numa_node_of_domain(uint32_t domain) {
+    for (uint32_t n = 0; n < numa.node_count; n++) {
+        if (numa.domains[n] == domain) {
+            return n;
+        }
+    }
+
+    if (numa.node_count == NUMA_MAX_NODES) {
+        return -1;
+    }
+    numa.domains[numa.node_count] = domain;
+    return numa.node_count++;
+}
+
+// SRAT girdilerini oku: bellek aralıkları ve açılış işlemcisinin düğümü
+static void numa_parse_srat(acpi_header_t* srat, uint32_t boot_apic_id) {
+    // Başlığın ardında 12 ayrılmış bayt var
+    uint8_t* entry = (uint8_t*)srat + sizeof(acpi_header_t) + 12;
+    uint8_t* end = (uint8_t*)srat + srat->length;
+
+    while (entry + 2 <= end && entry[1] >= 2 && entry + entry[1] <= end) {
+        int node = 0;
+
+        if (entry[0] == SRAT_PROCESSOR_APIC && entry[1] >= 16 && (*(uint32_t*)(entry + 4) & SRAT_ENABLED)) {
+            uint32_t domain = entry[2] | ((uint32_t)entry[9] << 8) | ((uint32_t)entry[10] << 16) | ((uint32_t)entry[11] << 24);
+            node = numa_node_of_domain(domain);
+            if (node >= 0 && entry[3] == boot_apic_id) {
+                numa.boot_node = node;
+            }
+        } else if (entry[0] == SRAT_PROCESSOR_X2APIC && entry[1] >= 24 && (*(uint32_t*)(entry + 12) & SRAT_ENABLED)) {
+            node = numa_node_of_domain(*(uint32_t*)(entry + 4));
+            if (node >= 0 && *(uint32_t*)(entry + 8) == boot_apic_id) {
+                numa.boot_node = node;
+            }
+        } else if (entry[0] == SRAT_MEMORY && entry[1] >= 40 && (*(uint32_t*)(entry + 28) & SRAT_ENABLED)) {
+            uint64_t base = *(uint64_t*)(entry + 8);
+            uint64_t length = *(uint64_t*)(entry + 16);
+            node = numa_node_of_domain(*(uint32_t*)(entry + 2));
+            if (node >= 0 && length && numa.range_count < NUMA_MAX_RANGES) {
+                numa_range_t* range = &numa.ranges[numa.range_count++];
+                range->start = base;
+                range->end = base + length;
+                range->node = node;
+            }
+        }
+
+        if (node < 0) {
+            terminal_writestring("Uyari: NUMA dugum siniri asildi, SRAT girdisi yok sayildi!\n");
+        }
+        entry += entry[1];
+    }
+}
+
+// SLIT'ten düğümler arası uzaklıkları oku
+static void numa_parse_slit(acpi_header_t* slit) {
+    uint64_t localities = *(uint64_t*)((uint8_t*)slit + sizeof(acpi_header_t));
+    uint8_t* matrix = (uint8_t*)slit + sizeof(acpi_header_t) + 8;
+    if (localities > 256 || sizeof(acpi_header_t) + 8 + localities * localities > slit->length) {
+        return;
+    }
+
+    for (uint32_t from = 0; from < numa.node_count; from++) {
+        for (uint32_t to = 0; to < numa.node_count; to++) {
+            uint64_t a = numa.domains[from];
+            uint64_t b = numa.domains[to];
+            if (a < localities && b < localities) {
+                numa.distance[from][to] = matrix[a * localities + b];
+            }
+        }
+    }
+}
+
+// SRAT ve SLIT'i oku; bulunamazsa tüm bellek tek düğümdür
+int numa_init(uint64_t phys_limit) {
+    memset(&numa, 0, sizeof(numa));
+    numa_phys_limit = phys_limit;
+
+    acpi_header_t* srat = acpi_find_table("SRAT");
+    if (srat) {
+        // İlk APIC kimliği CPUID yaprak 1, EBX[31:24]
+        uint32_t eax, ebx, ecx, edx;
+        asm volatile("cpuid" : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx) : "a" (1));
+        numa_parse_srat(srat, ebx >> 24);
+    }
+
+    // Bellek aralığı yoksa düğüm bilgisi kullanılamaz
+    if (numa.range_count == 0) {
+        memset(&numa, 0, sizeof(numa));
+        numa.node_count = 1;
+        numa.distance[0][0] = NUMA_LOCAL_DISTANCE;
+        return 0;
+    }
+
+    for (uint32_t from = 0; from < numa.node_count; from++) {
+        for (uint32_t to = 0; to < numa.node_count; to++) {
+            numa.distance[from][to] = from == to ? NUMA_LOCAL_DISTANCE : NUMA_REMOTE_DISTANCE;
+        }
+    }
+
+    acpi_header_t* slit = acpi_find_table("SLIT");
+    if (slit) {
+        numa_parse_slit(slit);
+    }
+
+    terminal_writestring("NUMA dugumu: ");
+    char count_str[12];
+    int_to_string(numa.node_count, count_str);
+    terminal_writestring(count_str);
+    terminal_writestring(slit ? " (SLIT uzakliklariyla)\n" : "\n");
+    return 1;
+}
+
+// Okunan düzeni al
+const numa_info_t* numa_get_info() {
+    return &numa;
+}
+
+// Fiziksel adresin düğümü (hiçbir aralıkta değilse 0)
+uint32_t numa_node_of(uint64_t phys) {
+    for (uint32_t i = 0; i < numa.range_count; i++) {
+        if (phys >= numa.ranges[i].start && phys < numa.ranges[i].end) {
+            return numa.ranges[i].node;
+        }
+    }
+    return 0;
+}
+
+// Çalışan işlemcinin düğümü
+// Kernel tek işlemcide çalışır; açılışta SRAT'ta bulunan düğüm döner
+uint32_t numa_current_node() {
+    return numa.boot_node;
+}
\ No newline at end of file
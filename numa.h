@@ -0,0 +1,81 @@
+#ifndef NUMA_H
+#define NUMA_H
+
+#include <stdint.h>
+
+// En fazla NUMA düğümü ve SRAT bellek aralığı
+#define NUMA_MAX_NODES   8
+#define NUMA_MAX_RANGES  32
+
+// SLIT yoksa kullanılan ACPI varsayılan uzaklıkları
+#define NUMA_LOCAL_DISTANCE  10
+#define NUMA_REMOTE_DISTANCE 20
+
+// RSDP'nin arandığı BIOS alanları
+#define ACPI_EBDA_POINTER    0x40E       // EBDA segmentini tutan BDA alanı
+#define ACPI_BIOS_START      0xE0000
+#define ACPI_BIOS_END        0x100000
+
+// SRAT girdi türleri
+#define SRAT_PROCESSOR_APIC  0
+#define SRAT_MEMORY          1
+#define SRAT_PROCESSOR_X2APIC 2
+
+// SRAT girdi bayrakları
+#define SRAT_ENABLED         0x1
+
+// ACPI tablo başlığı
+typedef struct {
+    char signature[4];
+    uint32_t length;             // Başlık dahil tablo boyutu
+    uint8_t revision;
+    uint8_t checksum;            // Tüm baytların toplamı 0 olmalı
+    char oem_id[6];
+    char oem_table_id[8];
+    uint32_t oem_revision;
+    uint32_t creator_id;
+    uint32_t creator_revision;
+} __attribute__((packed)) acpi_header_t;
+
+// Kök sistem tanımlayıcı işaretçisi (ACPI 2.0 alanlarıyla)
+typedef struct {
+    char signature[8];           // "RSD PTR "
+    uint8_t checksum;            // İlk 20 bayt için
+    char oem_id[6];
+    uint8_t revision;            // 0 = ACPI 1.0 (yalnız RSDT)
+    uint32_t rsdt_address;
+    uint32_t length;
+    uint64_t xsdt_address;
+    uint8_t extended_checksum;
+    uint8_t reserved[3];
+} __attribute__((packed)) acpi_rsdp_t;
+
+// Düğümün sahip olduğu fiziksel bellek aralığı
+typedef struct {
+    uint64_t start;              // Başlangıç adresi
+    uint64_t end;                // Bitiş adresi (dahil değil)
+    uint32_t node;               // Düğüm numarası
+} numa_range_t;
+
+// SRAT/SLIT'ten okunan düzen (SRAT yoksa tek düğüm)
+typedef struct {
+    uint32_t node_count;                           // Düğüm sayısı
+    uint32_t domains[NUMA_MAX_NODES];              // Düğümün ACPI yakınlık alanı
+    uint32_t range_count;                          // Bellek aralığı sayısı
+    numa_range_t ranges[NUMA_MAX_RANGES];
+    uint8_t distance[NUMA_MAX_NODES][NUMA_MAX_NODES]; // Düğümler arası göreli uzaklık
+    uint32_t boot_node;                            // Açılış işlemcisinin düğümü
+} numa_info_t;
+
+// ACPI tablolarını oku (sadece açılışta, doğrudan eşleme kurulduktan sonra)
+// phys_limit: doğrudan eşlemenin kapsadığı fiziksel sınır
+int numa_init(uint64_t phys_limit);
+const numa_info_t* numa_get_info();
+
+// Fiziksel adresin düğümü (hiçbir aralıkta değilse 0)
+uint32_t numa_node_of(uint64_t phys);
+
+// Çalışan işlemcinin düğümü
+uint32_t numa_current_node();
+
+#endif // NUMA_H
\ No newline at end of file
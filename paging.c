@@ -1,96 +1,763 @@
 #include "kernel.h"
 #include "paging.h"
+#include "vmalloc.h"
+#include "swap.h"
 
 // Fiziksel ve sanal bellek yöneticileri
 static physical_memory_manager_t pmm;
 static virtual_memory_manager_t vmm;
 
 // Kernel sayfa tablosu
-extern uint64_t boot_pml4;
+extern page_table_t boot_pml4;
+
+// Linker betiğinin tanımladığı kernel imajı sonu
+extern char _kernel_end[];
+
+// Okuma erişimindeki boş kullanıcı sayfalarının ortak eşlendiği sıfır çerçevesi
+static void* zero_page_phys = NULL;
+
+// Çekirdek yarısı kopyalanmış, alt yarısı boş PML4 havuzu
+#define PML4_POOL_SIZE 16
+
+static void* pml4_pool[PML4_POOL_SIZE];
+static uint32_t pml4_pool_count = 0;
+
+// Önceden sıfırlanmış sayfa havuzu
+#define ZERO_POOL_SIZE 64          // Havuz kapasitesi (sayfa)
+#define ZERO_POOL_REFILL_BATCH 8   // Boşta döngüsünde bir seferde sıfırlanan sayfa
+
+static void* zero_pool[ZERO_POOL_SIZE];
+
+// Geri kazanılabilir kullanıcı sayfalarının LRU listeleri (page_t next/prev, baş en yeni)
+typedef struct {
+    page_t* head;
+    page_t* tail;
+} lru_list_t;
+
+static lru_list_t lru_active_list;
+static lru_list_t lru_inactive_list;
+
+// Düşük bellek bildirimi alan alt sistemler
+static mem_pressure_callback_t pressure_callbacks[MEM_PRESSURE_MAX_CALLBACKS];
+static uint32_t pressure_callback_count = 0;
+static int reclaim_running = 0;           // Geri kazanım içinden yeniden girilmesin
+
+// TLB etiketleme durumu
+static int pge_enabled = 0;               // CR4.PGE açık
+static int pcid_enabled = 0;              // CR4.PCIDE açık
+static int invpcid_supported = 0;         // INVPCID komutu var
+static uint64_t pcid_owner[PCID_COUNT];   // PCID'yi kullanan PML4 (fiziksel, 0 = boş)
+static uint8_t pcid_stale[PCID_COUNT];    // Sonraki CR3 yüklemesinde temizlenmeli
+static uint32_t pcid_next_victim = 1;     // Geri dönüşümde sıradaki aday
+static uint32_t active_pcid = 0;          // CR3'teki PCID
+static uint64_t active_pml4 = 0;          // CR3'teki PML4 (fiziksel)
+
+// Kernel yarısındaki yaprak girişler tüm adres alanlarında ortaktır, global işaretlenir
+static inline uint64_t paging_global_flag(uint64_t virt_addr) {
+    return virt_addr >= PHYS_MAP_BASE ? PAGE_GLOBAL : 0;
+}
+
+// vmm.pml4'ün fiziksel adresi (boot tablosu kimlik eşlemesi içinde)
+static uint64_t paging_pml4_phys(page_table_t* pml4) {
+    if (pml4 == &boot_pml4) {
+        return (uint64_t)&boot_pml4;
+    }
+    return virt_to_phys(pml4);
+}
+
+// PML4'e atanmış PCID'yi bul (-1 = yok)
+static int pcid_find(uint64_t pml4_phys) {
+    for (int i = 0; i < PCID_COUNT; i++) {
+        if (pcid_owner[i] == pml4_phys) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// INVPCID komutu
+static inline void paging_invpcid(uint64_t type, uint64_t pcid, uint64_t addr) {
+    struct {
+        uint64_t pcid;
+        uint64_t addr;
+    } desc = { pcid, addr };
+    asm volatile("invpcid %0, %1" : : "m" (desc), "r" (type) : "memory");
+}
+
+// Etkin olmayan bir adres alanının TLB girişlerini geçersiz kıl
+// (type INVPCID_ADDRESS ise yalnız addr, INVPCID_SINGLE_CONTEXT ise tümü)
+static void pcid_invalidate(uint64_t pml4_phys, uint64_t type, uint64_t addr) {
+    // PCID yoksa her CR3 yüklemesi TLB'yi temizler; etkin olmayan alanın girişi kalmaz
+    if (!pcid_enabled) {
+        return;
+    }
+    
+    // Etiketi olmayan adres alanının TLB'de girişi yoktur
+    int pcid = pcid_find(pml4_phys);
+    if (pcid < 0) {
+        return;
+    }
+    
+    if (invpcid_supported) {
+        paging_invpcid(type, pcid, addr);
+    } else {
+        // Sonraki geçişte CR3 NOFLUSH olmadan yüklenir
+        pcid_stale[pcid] = 1;
+    }
+}
 
 // TLB temizleme işlevi
 void paging_flush_tlb(void* addr) {
-    asm volatile("invlpg (%0)" : : "r" (addr) : "memory");
+    // Kernel adresleri ve etkin adres alanı doğrudan invlpg ile temizlenir
+    if (!pcid_enabled || (uint64_t)addr >= PHYS_MAP_BASE || paging_pml4_phys(vmm.pml4) == active_pml4) {
+        asm volatile("invlpg (%0)" : : "r" (addr) : "memory");
+        return;
+    }
+    
+    // Başka bir adres alanındaki kullanıcı adresi: yalnız onun PCID'si hedeflenir
+    pcid_invalidate(paging_pml4_phys(vmm.pml4), INVPCID_ADDRESS, (uint64_t)addr);
 }
 
-// Tüm TLB'yi temizle
-void paging_flush_tlb_all() {
-    // CR3 kaydedicisini tekrar yükleyerek tüm TLB'yi temizle
+// Etkin adres alanının global olmayan girişlerini temizle
+static void paging_flush_tlb_context() {
+    // PCID açıkken NOFLUSH'sız CR3 yazımı yalnız etkin PCID'yi temizler
     uint64_t cr3;
     asm volatile("mov %%cr3, %0" : "=r" (cr3));
     asm volatile("mov %0, %%cr3" : : "r" (cr3) : "memory");
 }
 
-// Fiziksel sayfa tahsis et (bitmap kullanarak)
-static void* pmm_alloc_page() {
-    // Bitmap'te boş bir bit ara
-    for (uint64_t i = 0; i < pmm.bitmap_size * 8; i++) {
-        uint64_t byte_index = i / 8;
-        uint64_t bit_index = i % 8;
-        uint8_t bit_mask = 1 << bit_index;
+// Tüm TLB'yi temizle (global girişler ve tüm PCID'ler dahil)
+void paging_flush_tlb_all() {
+    if (invpcid_supported && pcid_enabled) {
+        paging_invpcid(INVPCID_ALL_GLOBAL, 0, 0);
+        return;
+    }
+    
+    if (pge_enabled) {
+        // CR4.PGE'yi kapatıp açmak global girişler dahil her şeyi temizler
+        uint64_t rflags = irq_save();
+        uint64_t cr4;
+        asm volatile("mov %%cr4, %0" : "=r" (cr4));
+        asm volatile("mov %0, %%cr4" : : "r" (cr4 & ~(uint64_t)CR4_PGE) : "memory");
+        asm volatile("mov %0, %%cr4" : : "r" (cr4) : "memory");
+        irq_restore(rflags);
+        return;
+    }
+    
+    // CR3 kaydedicisini tekrar yükleyerek tüm TLB'yi temizle
+    paging_flush_tlb_context();
+}
+
+// Geçersiz kılınacak adresleri biriktir; eşik aşılırsa tek seferde tüm TLB temizlenir
+static void tlb_batch_add(tlb_batch_t* batch, uint64_t virt_addr) {
+    if (batch->count < TLB_BATCH_MAX) {
+        batch->addrs[batch->count++] = virt_addr;
+    } else {
+        batch->flush_all = 1;
+    }
+    
+    if (virt_addr >= PHYS_MAP_BASE) {
+        batch->global = 1;
+    }
+}
+
+// Biriken TLB geçersiz kılmalarını uygula
+static void tlb_batch_flush(tlb_batch_t* batch) {
+    if (batch->flush_all && batch->global) {
+        paging_flush_tlb_all();
+    } else if (batch->flush_all) {
+        // Yalnız kullanıcı adresleri: global kernel girişleri korunur
+        uint64_t target = paging_pml4_phys(vmm.pml4);
+        if (target == active_pml4) {
+            paging_flush_tlb_context();
+        } else {
+            pcid_invalidate(target, INVPCID_SINGLE_CONTEXT, 0);
+        }
+    } else {
+        for (uint32_t i = 0; i < batch->count; i++) {
+            paging_flush_tlb((void*)batch->addrs[i]);
+        }
+    }
+    
+    batch->count = 0;
+    batch->flush_all = 0;
+    batch->global = 0;
+}
+
+// Sayfa çerçevesini içeren bölgeyi bul (bölgeler sıralı, ikili arama)
+static pmm_region_t* pmm_region_of(uint64_t pfn) {
+    uint32_t low = 0;
+    uint32_t high = pmm.region_count;
+    
+    while (low < high) {
+        uint32_t mid = (low + high) / 2;
+        pmm_region_t* region = &pmm.regions[mid];
         
-        // Bit 0 ise (sayfa boş), tahsis et
-        if (!(pmm.bitmap[byte_index] & bit_mask)) {
-            // Sayfayı işaretle (1 = kullanımda)
-            pmm.bitmap[byte_index] |= bit_mask;
-            
-            // Bellek istatistiklerini güncelle
-            pmm.free_memory -= PAGE_SIZE;
-            pmm.used_memory += PAGE_SIZE;
-            
-            // Fiziksel adresi döndür
-            void* addr = (void*)(i * PAGE_SIZE);
-            
-            // Sayfa içeriğini temizle
-            memset(addr, 0, PAGE_SIZE);
-            
-            return addr;
+        if (pfn < region->start_pfn) {
+            high = mid;
+        } else if (pfn >= region->start_pfn + region->page_count) {
+            low = mid + 1;
+        } else {
+            return region;
         }
     }
     
-    terminal_writestring("Hata: Fiziksel bellek doldu!\n");
     return NULL;
 }
 
-// Fiziksel sayfayı serbest bırak
-static void pmm_free_page(void* addr) {
-    // Adresin PAGE_SIZE ile hizalı olduğunu kontrol et
-    if ((uint64_t)addr % PAGE_SIZE != 0) {
-        terminal_writestring("Hata: Hizalanmamis adres serbest birakilmaya calisiliyor!\n");
+// Çerçevenin tanımlayıcısı
+static inline page_t* pmm_page(pmm_region_t* region, uint64_t pfn) {
+    return &region->pages[pfn - region->start_pfn];
+}
+
+// Sayfa kullanımda mı? (en az bir sahibi var)
+static inline int pmm_page_used(pmm_region_t* region, uint64_t pfn) {
+    return pmm_page(region, pfn)->refcount != 0;
+}
+
+// Sayfa aralığını tek sahipli ya da boş olarak işaretle
+static void pmm_pages_set(pmm_region_t* region, uint64_t pfn, uint64_t count, int used) {
+    for (page_t* page = pmm_page(region, pfn); page < pmm_page(region, pfn + count); page++) {
+        page->refcount = used ? 1 : 0;
+        page->flags = 0;
+        page->mapping = 0;
+        page->index = 0;
+    }
+}
+
+// Sayfayı listenin başına ekle
+static void lru_list_add(lru_list_t* list, page_t* page) {
+    page->prev = NULL;
+    page->next = list->head;
+    if (list->head) {
+        list->head->prev = page;
+    } else {
+        list->tail = page;
+    }
+    list->head = page;
+}
+
+// Sayfayı listeden çıkar
+static void lru_list_remove(lru_list_t* list, page_t* page) {
+    if (page->prev) {
+        page->prev->next = page->next;
+    } else {
+        list->head = page->next;
+    }
+    if (page->next) {
+        page->next->prev = page->prev;
+    } else {
+        list->tail = page->prev;
+    }
+    page->next = NULL;
+    page->prev = NULL;
+}
+
+// Sayfayı bulunduğu LRU listesinden çıkar
+static void lru_del(page_t* page) {
+    if (!(page->flags & PG_LRU)) {
         return;
     }
     
-    // Bit indeksini hesapla
-    uint64_t bit_index = (uint64_t)addr / PAGE_SIZE;
+    uint64_t rflags = irq_save();
+    if (page->flags & PG_ACTIVE) {
+        lru_list_remove(&lru_active_list, page);
+        pmm.lru_active--;
+    } else {
+        lru_list_remove(&lru_inactive_list, page);
+        pmm.lru_inactive--;
+    }
+    page->flags &= ~(PG_LRU | PG_ACTIVE);
+    irq_restore(rflags);
+}
+
+// Sayfayı etkin ya da etkin olmayan listenin başına koy
+static void lru_add(page_t* page, int active) {
+    uint64_t rflags = irq_save();
+    lru_del(page);
+    if (active) {
+        lru_list_add(&lru_active_list, page);
+        page->flags |= PG_LRU | PG_ACTIVE;
+        pmm.lru_active++;
+    } else {
+        lru_list_add(&lru_inactive_list, page);
+        page->flags |= PG_LRU;
+        pmm.lru_inactive++;
+    }
+    irq_restore(rflags);
+}
+
+// Serbest buddy bloğunu bölgenin düğümündeki derece listesine ekle
+static void buddy_list_insert(pmm_region_t* region, uint64_t pfn, uint32_t order) {
+    pmm_free_block_t* block = (pmm_free_block_t*)phys_to_virt(pfn * PAGE_SIZE);
+    pmm_node_t* node = &pmm.nodes[region->node];
+    
+    block->prev = NULL;
+    block->next = node->free_lists[order];
+    if (block->next) {
+        block->next->prev = block;
+    }
+    node->free_lists[order] = block;
+    node->free_blocks[order]++;
+    node->free_pages += 1ULL << order;
+    
+    // Blok başını derecesiyle işaretle
+    page_t* head = pmm_page(region, pfn);
+    head->flags |= PG_BUDDY;
+    head->order = order;
+}
+
+// Serbest buddy bloğunu derece listesinden çıkar
+static void buddy_list_remove(pmm_region_t* region, uint64_t pfn, uint32_t order) {
+    pmm_free_block_t* block = (pmm_free_block_t*)phys_to_virt(pfn * PAGE_SIZE);
+    pmm_node_t* node = &pmm.nodes[region->node];
+    
+    if (block->prev) {
+        block->prev->next = block->next;
+    } else {
+        node->free_lists[order] = block->next;
+    }
+    if (block->next) {
+        block->next->prev = block->prev;
+    }
+    node->free_blocks[order]--;
+    node->free_pages -= 1ULL << order;
+    
+    pmm_page(region, pfn)->flags &= ~PG_BUDDY;
+}
+
+// Bloğu serbest buddy'leriyle birleştirerek listelere geri koy
+static void buddy_release(pmm_region_t* region, uint64_t pfn, uint32_t order) {
+    uint64_t region_end = region->start_pfn + region->page_count;
+    
+    while (order < PMM_MAX_ORDER - 1) {
+        uint64_t buddy = pfn ^ (1ULL << order);
+        
+        // Buddy bölge dışındaysa ya da aynı derecede serbest bir blok başı değilse dur
+        if (buddy < region->start_pfn || buddy + (1ULL << order) > region_end ||
+            !(pmm_page(region, buddy)->flags & PG_BUDDY) || pmm_page(region, buddy)->order != order) {
+            break;
+        }
+        
+        buddy_list_remove(region, buddy, order);
+        if (buddy < pfn) {
+            pfn = buddy;
+        }
+        order++;
+    }
+    
+    buddy_list_insert(region, pfn, order);
+}
+
+// Boş bir sayfa aralığını hizalı en büyük bloklar halinde listelere ekle (açılışta)
+static void buddy_release_run(pmm_region_t* region, uint64_t pfn, uint64_t end) {
+    while (pfn < end) {
+        uint32_t order = PMM_MAX_ORDER - 1;
+        while (order > 0 && ((pfn & ((1ULL << order) - 1)) || pfn + (1ULL << order) > end)) {
+            order--;
+        }
+        
+        buddy_release(region, pfn, order);
+        pfn += 1ULL << order;
+    }
+}
+
+// Buddy listelerinden 2^order ardışık sayfa al (yer yoksa NULL)
+// Önce çalışan işlemcinin düğümü, sonra uzaklık sırasıyla diğer düğümler denenir
+static void* buddy_alloc(uint32_t order) {
+    pmm_node_t* local = &pmm.nodes[numa_current_node()];
+    pmm_node_t* node = NULL;
+    uint32_t current = PMM_MAX_ORDER;
+    
+    for (uint32_t i = 0; i < pmm.node_count && current == PMM_MAX_ORDER; i++) {
+        node = &pmm.nodes[local->fallback[i]];
+        
+        // İsteği karşılayan en küçük dereceli serbest bloğu bul
+        current = order;
+        while (current < PMM_MAX_ORDER && !node->free_lists[current]) {
+            current++;
+        }
+    }
+    
+    if (current == PMM_MAX_ORDER) {
+        return NULL;
+    }
+    
+    if (node == local) {
+        local->local_allocs++;
+    } else {
+        local->remote_allocs++;
+    }
+    
+    uint64_t pfn = virt_to_phys(node->free_lists[current]) / PAGE_SIZE;
+    pmm_region_t* region = pmm_region_of(pfn);
+    buddy_list_remove(region, pfn, current);
+    
+    // Fazla yarıları alt derecelere böl
+    while (current > order) {
+        current--;
+        buddy_list_insert(region, pfn + (1ULL << current), current);
+    }
+    
+    // Sayfaları tek sahipli olarak işaretle
+    pmm_pages_set(region, pfn, 1ULL << order, 1);
+    
+    // Bellek istatistiklerini güncelle
+    pmm.free_memory -= PAGE_SIZE << order;
+    pmm.used_memory += PAGE_SIZE << order;
+    
+    return (void*)(pfn * PAGE_SIZE);
+}
+
+// Havuzdan sıfırlanmış bir sayfa al (havuz boşsa NULL)
+static void* zero_pool_take() {
+    uint64_t rflags = irq_save();
+    
+    void* addr = NULL;
+    if (pmm.zero_pool_count > 0) {
+        addr = zero_pool[--pmm.zero_pool_count];
+        paging_phys_to_page(addr)->flags &= ~PG_ZERO;
+        
+        // Havuzdaki sayfalar serbest sayılır
+        pmm.free_memory -= PAGE_SIZE;
+        pmm.used_memory += PAGE_SIZE;
+    }
+    
+    irq_restore(rflags);
+    return addr;
+}
+
+// Havuzdaki tüm sayfaları buddy listelerine geri ver
+static void zero_pool_drain() {
+    while (pmm.zero_pool_count > 0) {
+        uint64_t pfn = (uint64_t)zero_pool[--pmm.zero_pool_count] / PAGE_SIZE;
+        pmm_region_t* region = pmm_region_of(pfn);
+        
+        // İstatistikler değişmez, sayfa zaten serbest sayılıyordu
+        pmm_pages_set(region, pfn, 1, 0);
+        buddy_release(region, pfn, 0);
+    }
+}
+
+// Havuzdaki boş PML4'leri buddy listelerine geri ver
+static void pml4_pool_drain() {
+    while (pml4_pool_count > 0) {
+        uint64_t pfn = (uint64_t)pml4_pool[--pml4_pool_count] / PAGE_SIZE;
+        pmm_region_t* region = pmm_region_of(pfn);
+        
+        // Havuzdaki tablolar kullanımda sayılıyordu
+        pmm_pages_set(region, pfn, 1, 0);
+        buddy_release(region, pfn, 0);
+        pmm.free_memory += PAGE_SIZE;
+        pmm.used_memory -= PAGE_SIZE;
+    }
+}
+
+// 2^order ardışık fiziksel sayfa tahsis et (buddy ayırıcı)
+static void* pmm_alloc_pages(uint32_t order) {
+    if (order >= PMM_MAX_ORDER) {
+        return NULL;
+    }
+    
+    // En düşük eşiğin altında tahsis eden de geri kazanıma katılır
+    uint64_t free_pages = pmm.free_memory / PAGE_SIZE;
+    if (free_pages < pmm.watermark_min) {
+        paging_reclaim(pmm.watermark_low - free_pages, MEM_PRESSURE_LOW);
+    }
+    
+    void* addr = buddy_alloc(order);
+    if (!addr) {
+        // Son çare: sıfır havuzunu boşalt, ne bulunursa geri kazanıp tekrar dene
+        zero_pool_drain();
+        paging_reclaim(1ULL << order, MEM_PRESSURE_CRITICAL);
+        addr = buddy_alloc(order);
+    }
+    
+    if (!addr) {
+        terminal_writestring("Hata: Fiziksel bellek doldu!\n");
+        return NULL;
+    }
+    
+    return addr;
+}
+
+// 2^order ardışık fiziksel sayfayı serbest bırak
+static void pmm_free_pages(void* addr, uint32_t order) {
+    uint64_t pfn = (uint64_t)addr / PAGE_SIZE;
+    
+    // Adresin blok boyutuyla hizalı olduğunu kontrol et
+    if ((uint64_t)addr % PAGE_SIZE != 0 || order >= PMM_MAX_ORDER || (pfn & ((1ULL << order) - 1))) {
+        terminal_writestring("Hata: Hizalanmamis adres serbest birakilmaya calisiliyor!\n");
+        return;
+    }
     
-    // Bit zaten 0 ise (sayfa zaten boş), hata
-    if (!(pmm.bitmap[bit_index / 8] & (1 << (bit_index % 8)))) {
-        terminal_writestring("Hata: Zaten serbest olan sayfa serbest birakilmaya calisiliyor!\n");
+    // Blok tek bir bölgenin içinde olmalı
+    pmm_region_t* region = pmm_region_of(pfn);
+    if (!region || pfn + (1ULL << order) > region->start_pfn + region->page_count) {
+        terminal_writestring("Hata: Yonetilmeyen fiziksel adres serbest birakilmaya calisiliyor!\n");
         return;
     }
     
-    // Biti temizle (0 = boş)
-    pmm.bitmap[bit_index / 8] &= ~(1 << (bit_index % 8));
+    // Sayfalardan biri zaten boşsa ya da ayrılmışsa, hata
+    for (uint64_t i = pfn; i < pfn + (1ULL << order); i++) {
+        if (!pmm_page_used(region, i)) {
+            terminal_writestring("Hata: Zaten serbest olan sayfa serbest birakilmaya calisiliyor!\n");
+            return;
+        }
+        if (pmm_page(region, i)->flags & PG_RESERVED) {
+            terminal_writestring("Hata: Ayrilmis sayfa serbest birakilmaya calisiliyor!\n");
+            return;
+        }
+    }
+    
+    // Geri kazanım listelerinden çıkar, tanımlayıcıları sıfırla (0 = boş)
+    for (uint64_t i = pfn; i < pfn + (1ULL << order); i++) {
+        lru_del(pmm_page(region, i));
+    }
+    pmm_pages_set(region, pfn, 1ULL << order, 0);
     
     // Bellek istatistiklerini güncelle
-    pmm.free_memory += PAGE_SIZE;
-    pmm.used_memory -= PAGE_SIZE;
+    pmm.free_memory += PAGE_SIZE << order;
+    pmm.used_memory -= PAGE_SIZE << order;
+    
+    buddy_release(region, pfn, order);
+}
+
+// Fiziksel sayfa tahsis et (PAGE_ALLOC_ZERO ile sıfırlanmış sayfa)
+static void* pmm_alloc_page(uint32_t alloc_flags) {
+    if (!(alloc_flags & PAGE_ALLOC_ZERO)) {
+        return pmm_alloc_pages(0);
+    }
+    
+    // Önce boşta döngüsünün hazırladığı sayfaları dene
+    void* addr = zero_pool_take();
+    if (addr) {
+        pmm.zero_pool_hits++;
+        return addr;
+    }
+    pmm.zero_pool_misses++;
+    
+    addr = pmm_alloc_pages(0);
+    if (!addr) {
+        return NULL;
+    }
+    
+    // Sayfa içeriğini doğrudan eşleme üzerinden temizle
+    memset(phys_to_virt((uint64_t)addr), 0, PAGE_SIZE);
+    
+    return addr;
+}
+
+// Fiziksel sayfayı serbest bırak
+static void pmm_free_page(void* addr) {
+    pmm_free_pages(addr, 0);
+}
+
+// Adres aralığını kullanımda olarak işaretle (sadece açılışta)
+static void pmm_reserve_range(uint64_t start, uint64_t end) {
+    uint64_t first = start / PAGE_SIZE;
+    uint64_t last = (end + PAGE_SIZE - 1) / PAGE_SIZE;
+    
+    for (uint32_t r = 0; r < pmm.region_count; r++) {
+        pmm_region_t* region = &pmm.regions[r];
+        uint64_t from = first > region->start_pfn ? first : region->start_pfn;
+        uint64_t to = region->start_pfn + region->page_count;
+        if (last < to) {
+            to = last;
+        }
+        
+        // Sadece yeni işaretlenen sayfaları say ki istatistikler kesin kalsın
+        for (uint64_t pfn = from; pfn < to; pfn++) {
+            if (!pmm_page_used(region, pfn)) {
+                pmm_pages_set(region, pfn, 1, 1);
+                pmm_page(region, pfn)->flags |= PG_RESERVED;
+                pmm.free_memory -= PAGE_SIZE;
+                pmm.used_memory += PAGE_SIZE;
+            }
+        }
+    }
+}
+
+// DMA havuzu için 4 GB altında, boyutuna hizalı boş bir aralık ayır (sadece açılışta)
+// Havuz buddy listelerine hiç girmez; dma.c onu kendi içinde dağıtır
+static void pmm_reserve_dma_pool() {
+    uint64_t pages = PMM_DMA_POOL_PAGES;
+    while (pages > 16 && pages > pmm.total_pages / PMM_DMA_POOL_DIVISOR) {
+        pages /= 2;
+    }
+    
+    pmm.dma_pool_start = 0;
+    pmm.dma_pool_pages = 0;
+    
+    for (uint32_t r = 0; r < pmm.region_count; r++) {
+        pmm_region_t* region = &pmm.regions[r];
+        uint64_t end = region->start_pfn + region->page_count;
+        if (end > PMM_DMA_LIMIT / PAGE_SIZE) {
+            end = PMM_DMA_LIMIT / PAGE_SIZE;
+        }
+        
+        uint64_t pfn = (region->start_pfn + pages - 1) & ~(pages - 1);
+        while (pfn + pages <= end) {
+            // Aralıkta kullanımda sayfa varsa onun ardındaki hizalı adresten devam et
+            uint64_t used = pfn + pages;
+            for (uint64_t i = pfn; i < pfn + pages; i++) {
+                if (pmm_page_used(region, i)) {
+                    used = i;
+                    break;
+                }
+            }
+            
+            if (used == pfn + pages) {
+                pmm_reserve_range(pfn * PAGE_SIZE, (pfn + pages) * PAGE_SIZE);
+                pmm.dma_pool_start = pfn * PAGE_SIZE;
+                pmm.dma_pool_pages = pages;
+                return;
+            }
+            pfn = (used + pages) & ~(pages - 1);
+        }
+    }
+    
+    terminal_writestring("Uyari: DMA havuzu icin 4 GB altinda yer bulunamadi!\n");
+}
+
+// Bölgeyi pfn'de ikiye böl (sadece açılışta, tanımlayıcılar dağıtılmadan önce)
+static void pmm_split_region(uint64_t pfn) {
+    pmm_region_t* region = pmm_region_of(pfn);
+    if (!region || region->start_pfn == pfn) {
+        return;
+    }
+    
+    if (pmm.region_count >= PMM_MAX_REGIONS) {
+        terminal_writestring("Uyari: Cok fazla bellek bolgesi, NUMA siniri bolunemedi!\n");
+        return;
+    }
+    
+    uint32_t i = region - pmm.regions;
+    for (uint32_t j = pmm.region_count; j > i + 1; j--) {
+        pmm.regions[j] = pmm.regions[j - 1];
+    }
+    pmm.regions[i + 1].start_pfn = pfn;
+    pmm.regions[i + 1].page_count = region->start_pfn + region->page_count - pfn;
+    region->page_count = pfn - region->start_pfn;
+    pmm.region_count++;
+}
+
+// Bölgeleri NUMA düğümlerine ata ve her düğümün yedek sırasını uzaklığa göre kur
+static void pmm_init_nodes() {
+    const numa_info_t* numa = numa_get_info();
+    
+    memset(pmm.nodes, 0, sizeof(pmm.nodes));
+    pmm.node_count = numa->node_count;
+    
+    // Her bölge tek düğümde kalsın ki buddy blokları düğüm sınırında birleşmesin
+    for (uint32_t i = 0; i < numa->range_count; i++) {
+        pmm_split_region((numa->ranges[i].start + PAGE_SIZE - 1) / PAGE_SIZE);
+        pmm_split_region(numa->ranges[i].end / PAGE_SIZE);
+    }
+    
+    for (uint32_t r = 0; r < pmm.region_count; r++) {
+        pmm_region_t* region = &pmm.regions[r];
+        region->node = numa_node_of(region->start_pfn * PAGE_SIZE);
+        pmm.nodes[region->node].total_pages += region->page_count;
+    }
+    
+    // Yedek sıra: uzaklığa göre kararlı eklemeli sıralama (düğüm kendine en yakındır)
+    for (uint32_t n = 0; n < pmm.node_count; n++) {
+        uint32_t* order = pmm.nodes[n].fallback;
+        for (uint32_t i = 0; i < pmm.node_count; i++) {
+            uint32_t candidate = (n + i) % pmm.node_count;
+            uint32_t j = i;
+            while (j > 0 && numa->distance[n][order[j - 1]] > numa->distance[n][candidate]) {
+                order[j] = order[j - 1];
+                j--;
+            }
+            order[j] = candidate;
+        }
+    }
+}
+
+// Kullanılabilir sayfa aralığını sıralı bölge listesine ekle (örtüşenleri birleştir)
+static void pmm_add_region(uint64_t start_pfn, uint64_t end_pfn) {
+    uint32_t i = 0;
+    while (i < pmm.region_count && pmm.regions[i].start_pfn + pmm.regions[i].page_count < start_pfn) {
+        i++;
+    }
+    
+    // Komşu ya da örtüşen bölgeleri yut
+    while (i < pmm.region_count && pmm.regions[i].start_pfn <= end_pfn) {
+        uint64_t region_end = pmm.regions[i].start_pfn + pmm.regions[i].page_count;
+        if (pmm.regions[i].start_pfn < start_pfn) {
+            start_pfn = pmm.regions[i].start_pfn;
+        }
+        if (region_end > end_pfn) {
+            end_pfn = region_end;
+        }
+        
+        for (uint32_t j = i; j + 1 < pmm.region_count; j++) {
+            pmm.regions[j] = pmm.regions[j + 1];
+        }
+        pmm.region_count--;
+    }
+    
+    if (pmm.region_count >= PMM_MAX_REGIONS) {
+        terminal_writestring("Hata: Cok fazla bellek bolgesi, fazlasi yok sayiliyor!\n");
+        return;
+    }
+    
+    for (uint32_t j = pmm.region_count; j > i; j--) {
+        pmm.regions[j] = pmm.regions[j - 1];
+    }
+    pmm.regions[i].start_pfn = start_pfn;
+    pmm.regions[i].page_count = end_pfn - start_pfn;
+    pmm.region_count++;
+}
+
+// Ayrılmış sayfa aralığını bölgelerden çıkar (gerekirse bölgeyi ikiye böl)
+static void pmm_remove_range(uint64_t start_pfn, uint64_t end_pfn) {
+    uint32_t i = 0;
+    while (i < pmm.region_count) {
+        pmm_region_t* region = &pmm.regions[i];
+        uint64_t region_end = region->start_pfn + region->page_count;
+        
+        if (end_pfn <= region->start_pfn || start_pfn >= region_end) {
+            i++;
+            continue;
+        }
+        
+        if (start_pfn <= region->start_pfn && end_pfn >= region_end) {
+            // Bölgenin tamamı ayrılmış, aynı indekste devam et
+            for (uint32_t j = i; j + 1 < pmm.region_count; j++) {
+                pmm.regions[j] = pmm.regions[j + 1];
+            }
+            pmm.region_count--;
+            continue;
+        } else if (start_pfn <= region->start_pfn) {
+            // Baştan kırp
+            region->page_count = region_end - end_pfn;
+            region->start_pfn = end_pfn;
+        } else if (end_pfn >= region_end) {
+            // Sondan kırp
+            region->page_count = start_pfn - region->start_pfn;
+        } else {
+            // Ortadan böl
+            region->page_count = start_pfn - region->start_pfn;
+            pmm_add_region(end_pfn, region_end);
+        }
+        i++;
+    }
 }
 
 // Sayfa tablosu girişi oluştur
 static uint64_t paging_make_entry(void* phys_addr, uint64_t flags) {
     // Adresin üst 40 bitini (12-51) al ve bayraklarla birleştir
-    return ((uint64_t)phys_addr & 0x000FFFFFFFFFF000) | flags;
+    return ((uint64_t)phys_addr & PAGE_ADDR_MASK) | flags;
 }
 
-// 4 seviyeli sayfa tablosunda sanal adresi fiziksel adrese çevir
-// (PML4 -> PDPT -> PD -> PT -> Fiziksel sayfa)
-static void* paging_walk(void* virt_addr, int alloc, uint64_t flags) {
-    uint64_t addr = (uint64_t)virt_addr;
+// Sanal adresin PD girişini bul (PML4 -> PDPT -> PD), gerekirse ara tabloları oluştur
+static uint64_t* paging_walk_pd(uint64_t addr, int alloc, uint64_t flags) {
     uint64_t pml4_index = (addr >> 39) & 0x1FF;
     uint64_t pdpt_index = (addr >> 30) & 0x1FF;
     uint64_t pd_index = (addr >> 21) & 0x1FF;
-    uint64_t pt_index = (addr >> 12) & 0x1FF;
     
     page_table_t* pml4 = vmm.pml4;
     
@@ -101,7 +768,7 @@ static void* paging_walk(void* virt_addr, int alloc, uint64_t flags) {
         }
         
         // Yeni PDPT tablosu oluştur
-        void* pdpt_phys = pmm_alloc_page();
+        void* pdpt_phys = pmm_alloc_page(PAGE_ALLOC_ZERO);
         if (!pdpt_phys) {
             return NULL;
         }
@@ -111,7 +778,12 @@ static void* paging_walk(void* virt_addr, int alloc, uint64_t flags) {
     }
     
     // PDPT tablosunu al
-    page_table_t* pdpt = (page_table_t*)((pml4->entries[pml4_index] & 0x000FFFFFFFFFF000));
+    page_table_t* pdpt = (page_table_t*)phys_to_virt(pml4->entries[pml4_index] & PAGE_ADDR_MASK);
+    
+    // 1 GB sayfalar sadece doğrudan eşlemede kullanılır, burada bölünmez
+    if (pdpt->entries[pdpt_index] & PAGE_SIZE_BIT) {
+        return NULL;
+    }
     
     // PDPT girişini kontrol et
     if (!(pdpt->entries[pdpt_index] & PAGE_PRESENT)) {
@@ -120,7 +792,7 @@ static void* paging_walk(void* virt_addr, int alloc, uint64_t flags) {
         }
         
         // Yeni PD tablosu oluştur
-        void* pd_phys = pmm_alloc_page();
+        void* pd_phys = pmm_alloc_page(PAGE_ALLOC_ZERO);
         if (!pd_phys) {
             return NULL;
         }
@@ -129,290 +801,1688 @@ static void* paging_walk(void* virt_addr, int alloc, uint64_t flags) {
         pdpt->entries[pdpt_index] = paging_make_entry(pd_phys, PAGE_PRESENT | PAGE_WRITABLE | flags);
     }
     
-    // PD tablosunu al
-    page_table_t* pd = (page_table_t*)((pdpt->entries[pdpt_index] & 0x000FFFFFFFFFF000));
+    // PD tablosunu al
+    page_table_t* pd = (page_table_t*)phys_to_virt(pdpt->entries[pdpt_index] & PAGE_ADDR_MASK);
+    
+    return &pd->entries[pd_index];
+}
+
+// 2 MB'lık eşlemeyi aynı fiziksel sayfaları gösteren 512 adet 4 KB girişe böl
+static int paging_split_huge_page(uint64_t* pd_entry, uint64_t addr) {
+    void* pt_phys = pmm_alloc_page(PAGE_ALLOC_ANY);
+    if (!pt_phys) {
+        terminal_writestring("Hata: Buyuk sayfa bolunemedi!\n");
+        return 0;
+    }
+    
+    // Büyük sayfanın izin bitleri 4 KB girişlere aynen geçer
+    uint64_t phys = *pd_entry & PAGE_ADDR_MASK & ~(PAGE_SIZE_2M - 1);
+    uint64_t flags = *pd_entry & 0xFFF & ~(uint64_t)PAGE_SIZE_BIT;
+    
+    page_table_t* pt = (page_table_t*)phys_to_virt((uint64_t)pt_phys);
+    for (uint64_t i = 0; i < 512; i++) {
+        pt->entries[i] = (phys + i * PAGE_SIZE) | flags;
+    }
+    
+    *pd_entry = paging_make_entry(pt_phys, flags | PAGE_WRITABLE);
+    
+    // Tek invlpg büyük sayfanın TLB girişini de geçersiz kılar
+    paging_flush_tlb((void*)(addr & ~(PAGE_SIZE_2M - 1)));
+    return 1;
+}
+
+// 4 seviyeli sayfa tablosunda sanal adresi fiziksel adrese çevir
+// (PML4 -> PDPT -> PD -> PT -> Fiziksel sayfa)
+// alloc verildiğinde adresi kapsayan büyük sayfa 4 KB girişlere bölünür;
+// sorgularda büyük sayfanın PD girişi döndürülür (izin bitleri aynıdır)
+static void* paging_walk(void* virt_addr, int alloc, uint64_t flags) {
+    uint64_t addr = (uint64_t)virt_addr;
+    uint64_t pt_index = (addr >> 12) & 0x1FF;
+    
+    uint64_t* pd_entry = paging_walk_pd(addr, alloc, flags);
+    if (!pd_entry) {
+        return NULL;
+    }
+    
+    // 2 MB'lık eşleme mi?
+    if (*pd_entry & PAGE_SIZE_BIT) {
+        if (!alloc) {
+            return (void*)pd_entry;
+        }
+        if (!paging_split_huge_page(pd_entry, addr)) {
+            return NULL;
+        }
+    }
+    
+    // PD girişini kontrol et
+    if (!(*pd_entry & PAGE_PRESENT)) {
+        if (!alloc) {
+            return NULL;
+        }
+        
+        // Yeni PT tablosu oluştur
+        void* pt_phys = pmm_alloc_page(PAGE_ALLOC_ZERO);
+        if (!pt_phys) {
+            return NULL;
+        }
+        
+        // PD girişini ayarla
+        *pd_entry = paging_make_entry(pt_phys, PAGE_PRESENT | PAGE_WRITABLE | flags);
+    }
+    
+    // PT tablosunu al
+    page_table_t* pt = (page_table_t*)phys_to_virt(*pd_entry & PAGE_ADDR_MASK);
+    
+    // PT girişini kontrol et ve döndür
+    return (void*)&pt->entries[pt_index];
+}
+
+// CPU 1 GB sayfaları destekliyor mu? (CPUID 0x80000001, EDX bit 26)
+static int paging_cpu_has_1g_pages() {
+    uint32_t eax, ebx, ecx, edx;
+    asm volatile("cpuid" : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx) : "a" (0x80000000));
+    if (eax < 0x80000001) {
+        return 0;
+    }
+    
+    asm volatile("cpuid" : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx) : "a" (0x80000001));
+    return (edx >> 26) & 1;
+}
+
+// Tüm fiziksel belleği PHYS_MAP_BASE'e büyük sayfalarla eşle
+// (tablolar kimlik eşlemesi içindeki önceden ayrılmış sayfalardan alınır)
+static void paging_build_direct_map(uint64_t phys_end, uint64_t tables, int use_1g_pages) {
+    page_table_t* pml4 = &boot_pml4;
+    
+    for (uint64_t phys = 0; phys < phys_end; phys += PAGE_SIZE_1G) {
+        uint64_t virt = PHYS_MAP_BASE + phys;
+        uint64_t pml4_index = (virt >> 39) & 0x1FF;
+        uint64_t pdpt_index = (virt >> 30) & 0x1FF;
+        
+        // Her 512 GB için bir PDPT
+        if (!(pml4->entries[pml4_index] & PAGE_PRESENT)) {
+            memset((void*)tables, 0, PAGE_SIZE);
+            pml4->entries[pml4_index] = paging_make_entry((void*)tables, PAGE_PRESENT | PAGE_WRITABLE);
+            tables += PAGE_SIZE;
+        }
+        page_table_t* pdpt = (page_table_t*)(pml4->entries[pml4_index] & PAGE_ADDR_MASK);
+        
+        if (use_1g_pages) {
+            pdpt->entries[pdpt_index] = phys | PAGE_PRESENT | PAGE_WRITABLE | PAGE_SIZE_BIT | PAGE_GLOBAL;
+            continue;
+        }
+        
+        // 1 GB sayfa yoksa her GB için 2 MB'lık 512 girişli bir PD
+        page_table_t* pd = (page_table_t*)tables;
+        tables += PAGE_SIZE;
+        for (uint64_t i = 0; i < 512; i++) {
+            pd->entries[i] = (phys + i * PAGE_SIZE_2M) | PAGE_PRESENT | PAGE_WRITABLE | PAGE_SIZE_BIT | PAGE_GLOBAL;
+        }
+        pdpt->entries[pdpt_index] = paging_make_entry(pd, PAGE_PRESENT | PAGE_WRITABLE);
+    }
+}
+
+// Global sayfaları ve CPU destekliyorsa PCID'yi etkinleştir
+// (CPUID 1: EDX bit 13 PGE, ECX bit 17 PCID; CPUID 7: EBX bit 10 INVPCID)
+static void paging_enable_tlb_tags() {
+    uint32_t eax, ebx, ecx, edx;
+    asm volatile("cpuid" : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx) : "a" (0));
+    uint32_t max_leaf = eax;
+    
+    asm volatile("cpuid" : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx) : "a" (1));
+    int has_pge = (edx >> 13) & 1;
+    int has_pcid = (ecx >> 17) & 1;
+    
+    if (max_leaf >= 7) {
+        asm volatile("cpuid" : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx) : "a" (7), "c" (0));
+        invpcid_supported = (ebx >> 10) & 1;
+    }
+    
+    uint64_t cr4;
+    asm volatile("mov %%cr4, %0" : "=r" (cr4));
+    if (has_pge) {
+        cr4 |= CR4_PGE;
+        pge_enabled = 1;
+    }
+    
+    // Kernel adres alanı PCID 0'ı kullanır (CR3'ün alt 12 biti zaten 0)
+    active_pml4 = (uint64_t)&boot_pml4;
+    active_pcid = 0;
+    pcid_owner[0] = active_pml4;
+    if (has_pcid) {
+        cr4 |= CR4_PCIDE;
+        pcid_enabled = 1;
+    } else {
+        invpcid_supported = 0;
+    }
+    
+    asm volatile("mov %0, %%cr4" : : "r" (cr4) : "memory");
+}
+
+// Verilen kernel adresinin PML4 girişi için PDPT tablosunu önceden ayır
+static void paging_reserve_kernel_slot(uint64_t virt_addr) {
+    uint64_t pml4_index = (virt_addr >> 39) & 0x1FF;
+    
+    if (!(vmm.pml4->entries[pml4_index] & PAGE_PRESENT)) {
+        void* pdpt_phys = pmm_alloc_page(PAGE_ALLOC_ZERO);
+        if (pdpt_phys) {
+            vmm.pml4->entries[pml4_index] = paging_make_entry(pdpt_phys, PAGE_PRESENT | PAGE_WRITABLE);
+        }
+    }
+}
+
+// Sayfalama başlatma
+void paging_init(memory_map_entry_t* mmap, uint32_t mmap_count) {
+    // Bellek haritasını tara ve toplam belleği hesapla
+    pmm.total_memory = 0;
+    pmm.free_memory = 0;
+    pmm.used_memory = 0;
+    pmm.reserved_memory = 0;
+    pmm.region_count = 0;
+    
+    // Kullanılabilir aralıkları sayfa sınırlarına içe doğru hizalayıp bölge yap
+    for (uint32_t i = 0; i < mmap_count; i++) {
+        if (mmap[i].type != MMAP_TYPE_AVAILABLE) {
+            pmm.reserved_memory += mmap[i].size;
+            continue;
+        }
+        
+        uint64_t start = mmap[i].start;
+        uint64_t end = mmap[i].start + mmap[i].size;
+        
+        // 1 MB altı BIOS, VGA ve gerçek mod yapılarına ait
+        if (start < PMM_LOW_MEMORY_END) {
+            start = PMM_LOW_MEMORY_END;
+        }
+        
+        uint64_t start_pfn = (start + PAGE_SIZE - 1) / PAGE_SIZE;
+        uint64_t end_pfn = end / PAGE_SIZE;
+        if (end_pfn > start_pfn) {
+            pmm_add_region(start_pfn, end_pfn);
+        }
+    }
+    
+    // Kullanılabilir girdilerle örtüşen ayrılmış/ACPI aralıklarını çıkar
+    for (uint32_t i = 0; i < mmap_count; i++) {
+        if (mmap[i].type != MMAP_TYPE_AVAILABLE) {
+            uint64_t start_pfn = mmap[i].start / PAGE_SIZE;
+            uint64_t end_pfn = (mmap[i].start + mmap[i].size + PAGE_SIZE - 1) / PAGE_SIZE;
+            pmm_remove_range(start_pfn, end_pfn);
+        }
+    }
+    
+    if (pmm.region_count == 0) {
+        terminal_writestring("Hata: Kullanilabilir fiziksel bellek bulunamadi!\n");
+        return;
+    }
+    
+    // Doğrudan eşlemenin kapsayacağı fiziksel aralık ve tablo sayısı
+    pmm_region_t* last_region = &pmm.regions[pmm.region_count - 1];
+    uint64_t phys_end = (last_region->start_pfn + last_region->page_count) * PAGE_SIZE;
+    phys_end = (phys_end + PAGE_SIZE_1G - 1) & ~(PAGE_SIZE_1G - 1);
+    if (phys_end > PHYS_MAP_SIZE) {
+        terminal_writestring("Uyari: Fiziksel bellek dogrudan esleme sinirini asiyor!\n");
+        phys_end = PHYS_MAP_SIZE;
+        pmm_remove_range(phys_end / PAGE_SIZE, (uint64_t)-1 / PAGE_SIZE);
+    }
+    
+    int use_1g_pages = paging_cpu_has_1g_pages();
+    uint64_t direct_map_tables = (phys_end + PAGE_SIZE_512G - 1) / PAGE_SIZE_512G;
+    if (!use_1g_pages) {
+        direct_map_tables += phys_end / PAGE_SIZE_1G;
+    }
+    
+    // Bölge başına meta veri boyutunu hesapla (sayfa başına bir tanımlayıcı)
+    pmm.total_pages = 0;
+    pmm.metadata_size = direct_map_tables * PAGE_SIZE;
+    for (uint32_t r = 0; r < pmm.region_count; r++) {
+        uint64_t pages = pmm.regions[r].page_count;
+        pmm.total_pages += pages;
+        pmm.metadata_size += pages * sizeof(page_t);
+    }
+    pmm.total_memory = pmm.total_pages * PAGE_SIZE;
+    pmm.free_memory = pmm.total_memory;
+    
+    // Meta veriyi kernelin arkasındaki ilk uygun yere koy; doğrudan eşleme
+    // tabloları henüz yalnız kimlik eşlemesiyle yazılabildiği için 1 GB altında kalmalı
+    uint64_t kernel_end = ((uint64_t)_kernel_end + PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1);
+    uint64_t metadata = 0;
+    for (uint32_t r = 0; r < pmm.region_count; r++) {
+        uint64_t start = pmm.regions[r].start_pfn * PAGE_SIZE;
+        uint64_t end = start + pmm.regions[r].page_count * PAGE_SIZE;
+        if (start < kernel_end) {
+            start = kernel_end;
+        }
+        
+        if (start + pmm.metadata_size <= end && start + direct_map_tables * PAGE_SIZE <= BOOT_IDENTITY_LIMIT) {
+            metadata = start;
+            break;
+        }
+    }
+    
+    if (metadata == 0) {
+        terminal_writestring("Hata: Fiziksel bellek meta verisi icin yer bulunamadi!\n");
+        return;
+    }
+    
+    // Doğrudan eşlemeyi kur; bundan sonra fiziksel belleğe hep onun üzerinden erişilir
+    paging_build_direct_map(phys_end, metadata, use_1g_pages);
+    
+    // ACPI SRAT/SLIT'ten düğümleri oku; bölgeler düğüm sınırlarında bölünür
+    numa_init(phys_end);
+    pmm_init_nodes();
+    
+    // Bölgelerin tanımlayıcı dizilerini dağıt, temizle (tüm sayfalar boş)
+    page_t* cursor = (page_t*)phys_to_virt(metadata + direct_map_tables * PAGE_SIZE);
+    for (uint32_t r = 0; r < pmm.region_count; r++) {
+        pmm_region_t* region = &pmm.regions[r];
+        
+        region->pages = cursor;
+        cursor += region->page_count;
+        
+        memset(region->pages, 0, region->page_count * sizeof(page_t));
+    }
+    
+    pmm.zero_pool_count = 0;
+    pmm.zero_pool_hits = 0;
+    pmm.zero_pool_misses = 0;
+    
+    // Geri kazanım eşikleri; tahsisler başarısız olmadan önce devreye girer
+    pmm.watermark_min = pmm.total_pages / PMM_WATERMARK_DIVISOR;
+    if (pmm.watermark_min < PMM_WATERMARK_MIN_PAGES) {
+        pmm.watermark_min = PMM_WATERMARK_MIN_PAGES;
+    }
+    pmm.watermark_low = pmm.watermark_min * 2;
+    pmm.watermark_high = pmm.watermark_min * 3;
+    
+    // Kernel imajını ve meta veriyi işaretle (kullanımda)
+    pmm_reserve_range(PMM_LOW_MEMORY_END, kernel_end);
+    pmm_reserve_range(metadata, metadata + pmm.metadata_size);
+    
+    // Cihazlara verilecek kesintisiz DMA havuzu; buddy blokları parçalanmadan önce ayrılır
+    pmm_reserve_dma_pool();
+    
+    // Boş sayfa dizilerini buddy listelerine dağıt (komşular birleşerek büyük bloklar oluşur)
+    for (uint32_t r = 0; r < pmm.region_count; r++) {
+        pmm_region_t* region = &pmm.regions[r];
+        uint64_t end = region->start_pfn + region->page_count;
+        uint64_t pfn = region->start_pfn;
+        
+        while (pfn < end) {
+            if (pmm_page_used(region, pfn)) {
+                pfn++;
+                continue;
+            }
+            
+            uint64_t run_end = pfn;
+            while (run_end < end && !pmm_page_used(region, run_end)) {
+                run_end++;
+            }
+            
+            buddy_release_run(region, pfn, run_end);
+            pfn = run_end;
+        }
+    }
+    
+    // Geçici PML4 tablosunu kullan
+    vmm.pml4 = &boot_pml4;
+    
+    // Kernel bölgelerinin PML4 girişlerini şimdiden oluştur; böylece sonradan
+    // kopyalanan kullanıcı adres alanları aynı alt tabloları paylaşır
+    paging_reserve_kernel_slot(KERNEL_HEAP_START);
+    paging_reserve_kernel_slot(KERNEL_BASE);
+    
+    // Ortak sıfır sayfası hiç serbest bırakılmaz
+    zero_page_phys = pmm_alloc_page(PAGE_ALLOC_ZERO);
+    if (zero_page_phys) {
+        paging_phys_to_page(zero_page_phys)->flags |= PG_RESERVED;
+    }
+    
+    // Global kernel sayfaları ve adres alanı etiketleri
+    paging_enable_tlb_tags();
+    
+    // kmalloc_pages sanal adres ayırıcısı
+    vmalloc_init();
+    
+    // Kernel de yazınca kopyala sayfalarına yazarken hata alsın
+    uint64_t cr0;
+    asm volatile("mov %%cr0, %0" : "=r" (cr0));
+    asm volatile("mov %0, %%cr0" : : "r" (cr0 | CR0_WP) : "memory");
+    
+    terminal_writestring("Sayfalama baslatildi. Bellek: ");
+    char buf[32];
+    int_to_string(pmm.total_memory / 1024 / 1024, buf);
+    terminal_writestring(buf);
+    terminal_writestring(" MB\n");
+}
+
+// Sayfa tahsis et
+void* paging_alloc_page(uint32_t alloc_flags) {
+    return pmm_alloc_page(alloc_flags);
+}
+
+// Sayfayı serbest bırak
+void paging_free_page(void* addr) {
+    pmm_free_page(addr);
+}
+
+// Fiziksel olarak ardışık 2^order sayfa tahsis et
+void* paging_alloc_pages(uint32_t order) {
+    return pmm_alloc_pages(order);
+}
+
+// Fiziksel olarak ardışık 2^order sayfayı serbest bırak
+void paging_free_pages(void* addr, uint32_t order) {
+    pmm_free_pages(addr, order);
+}
+
+// Fiziksel adresin tanımlayıcısı (yönetilmeyen adreste NULL)
+page_t* paging_phys_to_page(void* phys_addr) {
+    uint64_t pfn = (uint64_t)phys_addr / PAGE_SIZE;
+    pmm_region_t* region = pmm_region_of(pfn);
+    return region ? pmm_page(region, pfn) : NULL;
+}
+
+// Tanımlayıcının fiziksel adresi
+void* paging_page_to_phys(page_t* page) {
+    for (uint32_t r = 0; r < pmm.region_count; r++) {
+        pmm_region_t* region = &pmm.regions[r];
+        if (page >= region->pages && page < region->pages + region->page_count) {
+            return (void*)((region->start_pfn + (page - region->pages)) * PAGE_SIZE);
+        }
+    }
+    return NULL;
+}
+
+// Kullanıcı çerçevesinin sahip adres alanını ve sanal adresini kaydet
+static void paging_set_page_owner(void* phys_addr, void* user_pml4, void* virt_addr) {
+    page_t* page = paging_phys_to_page(phys_addr);
+    if (page) {
+        page->flags |= PG_USER;
+        page->mapping = (uint64_t)user_pml4;
+        page->index = (uint64_t)virt_addr;
+        
+        // Sahibi bilinen sayfa geri kazanılabilir; yeni sayfa etkin listeden başlar
+        lru_add(page, 1);
+    }
+}
+
+// Kayıtlı sahip adres alanı hâlâ bir PML4 mü? (değilse tabloları yürünmez)
+static int paging_owner_valid(page_t* page) {
+    if (!(page->flags & PG_USER)) {
+        return 0;
+    }
+    page_t* pml4_page = paging_phys_to_page((void*)page->mapping);
+    return pml4_page && (pml4_page->flags & PG_PML4);
+}
+
+// Sahibin bu çerçeveyi eşleyen sayfa tablosu girişi (yoksa NULL)
+// vmm.pml4 sahibinkine geçer, çağıran geri yükler
+static uint64_t* paging_owner_entry(page_t* page, void* phys_addr) {
+    if (!paging_owner_valid(page)) {
+        return NULL;
+    }
+    
+    vmm.pml4 = (page_table_t*)phys_to_virt(page->mapping);
+    // Erişimi kapalı (PROT_NONE) giriş de çerçeveyi tutar, geri kazanılabilir
+    uint64_t* pt_entry = (uint64_t*)paging_walk((void*)page->index, 0, 0);
+    if (!pt_entry || !(*pt_entry & (PAGE_PRESENT | PAGE_PROTNONE)) || (*pt_entry & PAGE_SIZE_BIT) ||
+        (*pt_entry & PAGE_ADDR_MASK) != (uint64_t)phys_addr) {
+        return NULL;
+    }
+    return pt_entry;
+}
+
+// Çerçeveye bir sahip daha ekle (ör. yazınca kopyala ile paylaşım)
+// Ayrılmış çerçeveler (ör. sıfır sayfası) sayılmaz
+void paging_page_get(void* phys_addr) {
+    page_t* page = paging_phys_to_page(phys_addr);
+    if (page && !(page->flags & PG_RESERVED)) {
+        page->refcount++;
+    }
+}
+
+// Çerçevenin bir sahibini bırak; son sahip bırakınca çerçeve serbest kalır
+void paging_page_put(void* phys_addr) {
+    page_t* page = paging_phys_to_page(phys_addr);
+    if (!page || (page->flags & PG_RESERVED)) {
+        return;
+    }
+    
+    if (page->refcount > 1) {
+        page->refcount--;
+    } else {
+        pmm_free_page((void*)((uint64_t)phys_addr & ~0xFFF));
+    }
+}
+
+// Çerçevenin sahip sayısı
+uint32_t paging_page_refcount(void* phys_addr) {
+    page_t* page = paging_phys_to_page(phys_addr);
+    return page ? page->refcount : 1;
+}
+
+// Etkin listenin sonundaki sayfaları yaşlandır: erişilmişse başa döner, erişilmemişse
+// etkin olmayan listeye iner
+static void lru_age_active(uint64_t nr_scan) {
+    page_table_t* original_pml4 = vmm.pml4;
+    
+    // Başa dönen sayfalar aynı turda yeniden incelenmez
+    if (nr_scan > pmm.lru_active) {
+        nr_scan = pmm.lru_active;
+    }
+    
+    for (uint64_t i = 0; i < nr_scan; i++) {
+        uint64_t rflags = irq_save();
+        page_t* page = lru_active_list.tail;
+        if (!page) {
+            irq_restore(rflags);
+            break;
+        }
+        
+        uint64_t* pt_entry = paging_owner_entry(page, paging_page_to_phys(page));
+        if (!pt_entry) {
+            // Sahibi artık eşlemiyor (ör. çoğaltma sonrası); izlenmez
+            lru_del(page);
+        } else if (*pt_entry & PAGE_ACCESSED) {
+            *pt_entry &= ~(uint64_t)PAGE_ACCESSED;
+            paging_flush_tlb((void*)page->index);
+            lru_add(page, 1);
+        } else {
+            lru_add(page, 0);
+        }
+        
+        vmm.pml4 = original_pml4;
+        irq_restore(rflags);
+    }
+}
+
+// Etkin olmayan listenin sonundan en fazla target sayfa serbest bırak
+// Temiz, tek sahipli sayfanın eşlemesi kaldırılır; ilk erişimde bölgesinden yeniden
+// doldurulur (dosyadan okunur ya da sıfırlanır). Değiştirilmiş sayfa takas alanının
+// bekleyen kümesine kopyalanır, girişte yuvası kalır
+static uint64_t lru_shrink_inactive(uint64_t nr_scan, uint64_t target) {
+    page_table_t* original_pml4 = vmm.pml4;
+    uint64_t freed = 0;
+    
+    if (nr_scan > pmm.lru_inactive) {
+        nr_scan = pmm.lru_inactive;
+    }
+    
+    for (uint64_t i = 0; i < nr_scan && freed < target; i++) {
+        uint64_t rflags = irq_save();
+        page_t* page = lru_inactive_list.tail;
+        if (!page) {
+            irq_restore(rflags);
+            break;
+        }
+        
+        void* phys = paging_page_to_phys(page);
+        uint64_t* pt_entry = paging_owner_entry(page, phys);
+        if (!pt_entry) {
+            lru_del(page);
+        } else if (*pt_entry & PAGE_ACCESSED) {
+            // Yeniden kullanılmış, etkin listeye döner
+            *pt_entry &= ~(uint64_t)PAGE_ACCESSED;
+            paging_flush_tlb((void*)page->index);
+            lru_add(page, 1);
+        } else if (page->refcount != 1 || (*pt_entry & PAGE_SHARED)) {
+            // Paylaşılan sayfa tek eşlemeden çıkarılamaz
+            lru_add(page, 0);
+        } else if (*pt_entry & PAGE_DIRTY) {
+            // Değiştirilmiş sayfa yeniden üretilemez; takas alanı yoksa listede kalır
+            uint64_t slot;
+            if (swap_out_page(phys, &slot)) {
+                *pt_entry = PAGE_SWAP_ENTRY(slot);
+                paging_flush_tlb((void*)page->index);
+                pmm_free_page(phys);
+                freed++;
+            } else {
+                lru_add(page, 0);
+            }
+        } else {
+            *pt_entry = 0;
+            paging_flush_tlb((void*)page->index);
+            pmm_free_page(phys);
+            freed++;
+        }
+        
+        vmm.pml4 = original_pml4;
+        irq_restore(rflags);
+        
+        // Dolan küme kesmeler açıkken tek sıralı yazma ile diske gider
+        if (swap_cluster_full()) {
+            swap_flush();
+        }
+    }
+    return freed;
+}
+
+// Düşük bellekte en az target sayfa geri kazanmaya çalış: havuzdaki boş PML4'ler,
+// bildirim alan alt sistemler (ör. boş slab'lar) ve LRU listeleri
+// Geri kazanılan sayfa sayısını döndürür
+uint64_t paging_reclaim(uint64_t target, uint32_t level) {
+    if (reclaim_running || target == 0) {
+        return 0;
+    }
+    reclaim_running = 1;
+    pmm.pressure_events++;
+    
+    uint64_t freed = pml4_pool_count;
+    pml4_pool_drain();
+    
+    for (uint32_t i = 0; i < pressure_callback_count; i++) {
+        freed += pressure_callbacks[i](level);
+    }
+    
+    // Etkin olmayan liste kısa kaldıkça etkin listeden beslenir; tahsis başarısızsa
+    // her turda yaşlandırılarak listeler birkaç kez dolaşılır
+    uint32_t passes = level == MEM_PRESSURE_CRITICAL ? 4 : 1;
+    for (uint32_t pass = 0; pass < passes && freed < target; pass++) {
+        if (level == MEM_PRESSURE_CRITICAL || pmm.lru_inactive <= pmm.lru_active) {
+            lru_age_active(LRU_SCAN_BATCH);
+        }
+        freed += lru_shrink_inactive(LRU_SCAN_BATCH, target - freed);
+    }
+    
+    // Yarım kalan takas kümesi de yazılır
+    swap_flush();
+    
+    pmm.reclaimed_pages += freed;
+    reclaim_running = 0;
+    return freed;
+}
+
+// Serbest bellek düşük eşiğin altındaysa yüksek eşiğe kadar geri kazan
+// (kernel boşta döngüsünden çağrılır)
+void paging_balance() {
+    uint64_t free_pages = pmm.free_memory / PAGE_SIZE;
+    if (free_pages < pmm.watermark_low) {
+        paging_reclaim(pmm.watermark_high - free_pages, MEM_PRESSURE_LOW);
+    }
+}
+
+// Düşük bellek bildirimi için işlev kaydet
+int paging_register_pressure_callback(mem_pressure_callback_t callback) {
+    if (pressure_callback_count >= MEM_PRESSURE_MAX_CALLBACKS) {
+        return 0;
+    }
+    pressure_callbacks[pressure_callback_count++] = callback;
+    return 1;
+}
+
+// Sıfır havuzunu doldur (kernel boşta döngüsünden, hlt öncesi çağrılır)
+void paging_refill_zero_pool() {
+    for (int i = 0; i < ZERO_POOL_REFILL_BATCH; i++) {
+        if (pmm.zero_pool_count >= ZERO_POOL_SIZE) {
+            return;
+        }
+        
+        uint64_t rflags = irq_save();
+        void* addr = buddy_alloc(0);
+        irq_restore(rflags);
+        
+        if (!addr) {
+            return;
+        }
+        
+        // Sıfırlama kesmeler açıkken yapılır
+        memset(phys_to_virt((uint64_t)addr), 0, PAGE_SIZE);
+        
+        rflags = irq_save();
+        if (pmm.zero_pool_count < ZERO_POOL_SIZE) {
+            zero_pool[pmm.zero_pool_count++] = addr;
+            paging_phys_to_page(addr)->flags |= PG_ZERO;
+            
+            // Havuzdaki sayfalar serbest sayılır
+            pmm.free_memory += PAGE_SIZE;
+            pmm.used_memory -= PAGE_SIZE;
+        } else {
+            pmm_free_pages(addr, 0);
+        }
+        irq_restore(rflags);
+    }
+}
+
+// Fiziksel bellek istatistiklerini döndür
+const physical_memory_manager_t* paging_get_pmm_info() {
+    return &pmm;
+}
+
+// Sanal adrese fiziksel sayfa eşle
+void* paging_map_page(void* phys_addr, void* virt_addr, uint64_t flags) {
+    // Sanal adresi sayfa adresine hizala
+    virt_addr = (void*)((uint64_t)virt_addr & ~0xFFF);
+    
+    // Sayfa tabloları oluştur ve son seviye PT girişini al
+    uint64_t* pt_entry = (uint64_t*)paging_walk(virt_addr, 1, flags);
+    if (!pt_entry) {
+        return NULL;
+    }
+    
+    // Son seviye giriş zaten mevcut mu?
+    if (*pt_entry & PAGE_PRESENT) {
+        terminal_writestring("Hata: Sayfa zaten eslemesi var!\n");
+        return NULL;
+    }
+    
+    // Sayfa tablosu girişini ayarla
+    *pt_entry = paging_make_entry(phys_addr, PAGE_PRESENT | flags | paging_global_flag((uint64_t)virt_addr));
+    
+    // TLB'yi temizle
+    paging_flush_tlb(virt_addr);
+    
+    return virt_addr;
+}
+
+// Sanal adresi eşlemesini kaldır
+void paging_unmap_page(void* virt_addr) {
+    // Adres bir büyük sayfanın içindeyse önce 4 KB girişlere böl
+    uint64_t* pd_entry = paging_walk_pd((uint64_t)virt_addr, 0, 0);
+    if (!pd_entry || !(*pd_entry & PAGE_PRESENT)) {
+        return; // Eşleme yok
+    }
+    if ((*pd_entry & PAGE_SIZE_BIT) && !paging_split_huge_page(pd_entry, (uint64_t)virt_addr)) {
+        return;
+    }
+    
+    // Son seviye PT girişini al (oluşturma)
+    uint64_t* pt_entry = (uint64_t*)paging_walk(virt_addr, 0, 0);
+    if (!pt_entry) {
+        return; // Eşleme yok
+    }
+    
+    // Sayfa tablosu girişini temizle
+    *pt_entry = 0;
+    
+    // TLB'yi temizle
+    paging_flush_tlb(virt_addr);
+}
+
+// Sanal adresin karşılık geldiği fiziksel adresi bul
+void* paging_get_physical_address(void* virt_addr) {
+    // Son seviye girişi al (oluşturma); büyük sayfada PD girişi gelir
+    uint64_t* pt_entry = (uint64_t*)paging_walk(virt_addr, 0, 0);
+    if (!pt_entry || !(*pt_entry & PAGE_PRESENT)) {
+        return NULL; // Eşleme yok
+    }
+    
+    // 2 MB sayfada offset 21 bittir
+    if (*pt_entry & PAGE_SIZE_BIT) {
+        return (void*)((*pt_entry & PAGE_ADDR_MASK & ~(PAGE_SIZE_2M - 1)) | ((uint64_t)virt_addr & (PAGE_SIZE_2M - 1)));
+    }
+    
+    // Fiziksel adres = PT girişinden sayfa adresi + sanal adresin offset
+    return (void*)((*pt_entry & PAGE_ADDR_MASK) | ((uint64_t)virt_addr & 0xFFF));
+}
+
+// Sanal adresi kapsayan eşlemenin boyutu (eşleme yoksa 0)
+uint64_t paging_get_page_size(void* virt_addr) {
+    uint64_t* entry = (uint64_t*)paging_walk(virt_addr, 0, 0);
+    if (!entry || !(*entry & PAGE_PRESENT)) {
+        return 0;
+    }
+    
+    return (*entry & PAGE_SIZE_BIT) ? PAGE_SIZE_2M : PAGE_SIZE;
+}
+
+// 2 MB'lık fiziksel sayfayı 2 MB hizalı sanal adrese tek PD girişiyle eşle
+void* paging_map_huge_page(void* phys_addr, void* virt_addr, uint64_t flags) {
+    if (((uint64_t)phys_addr | (uint64_t)virt_addr) & (PAGE_SIZE_2M - 1)) {
+        terminal_writestring("Hata: Buyuk sayfa adresi 2 MB hizali degil!\n");
+        return NULL;
+    }
+    
+    uint64_t* pd_entry = paging_walk_pd((uint64_t)virt_addr, 1, flags);
+    if (!pd_entry) {
+        return NULL;
+    }
+    
+    if (*pd_entry & PAGE_PRESENT) {
+        // Daha önce kullanılıp boşalmış bir PT varsa onu bırak
+        page_table_t* pt = (page_table_t*)phys_to_virt(*pd_entry & PAGE_ADDR_MASK);
+        int empty = !(*pd_entry & PAGE_SIZE_BIT);
+        for (int i = 0; empty && i < 512; i++) {
+            if (pt->entries[i] & PAGE_PRESENT) {
+                empty = 0;
+            }
+        }
+        
+        if (!empty) {
+            terminal_writestring("Hata: Sayfa zaten eslemesi var!\n");
+            return NULL;
+        }
+        pmm_free_page((void*)(*pd_entry & PAGE_ADDR_MASK));
+    }
+    
+    // PD girişini büyük sayfa olarak ayarla
+    *pd_entry = paging_make_entry(phys_addr, PAGE_PRESENT | PAGE_SIZE_BIT | flags | paging_global_flag((uint64_t)virt_addr));
+    
+    // TLB'yi temizle
+    paging_flush_tlb(virt_addr);
+    
+    return virt_addr;
+}
+
+// 2 MB'lık eşlemeyi kaldır, fiziksel adresini döndür
+void* paging_unmap_huge_page(void* virt_addr) {
+    uint64_t* pd_entry = paging_walk_pd((uint64_t)virt_addr, 0, 0);
+    if (!pd_entry || (*pd_entry & (PAGE_PRESENT | PAGE_SIZE_BIT)) != (PAGE_PRESENT | PAGE_SIZE_BIT)) {
+        return NULL;
+    }
+    
+    void* phys_addr = (void*)(*pd_entry & PAGE_ADDR_MASK & ~(PAGE_SIZE_2M - 1));
+    *pd_entry = 0;
+    
+    // TLB'yi temizle
+    paging_flush_tlb(virt_addr);
+    
+    return phys_addr;
+}
+
+// 2 MB'lık fiziksel blok al ve eşle; bellek parçalıysa sessizce başarısız olur
+static int paging_alloc_huge_at(uint64_t virt_addr, uint64_t flags, uint32_t alloc_flags) {
+    void* phys_addr = buddy_alloc(HUGE_PAGE_ORDER);
+    if (!phys_addr) {
+        return 0;
+    }
+    
+    if (alloc_flags & PAGE_ALLOC_ZERO) {
+        memset(phys_to_virt((uint64_t)phys_addr), 0, PAGE_SIZE_2M);
+    }
+    
+    if (!paging_map_huge_page(phys_addr, (void*)virt_addr, flags)) {
+        pmm_free_pages(phys_addr, HUGE_PAGE_ORDER);
+        return 0;
+    }
+    
+    return 1;
+}
+
+// Fiziksel olarak ardışık aralığı sanal aralığa eşle
+// Her sayfa tablosuna bir kez inilir, ardışık girişler tek döngüde doldurulur;
+// 2 MB hizalı tam parçalar büyük sayfayla eşlenir
+void* paging_map_range(void* phys_addr, void* virt_addr, uint64_t count, uint64_t flags) {
+    uint64_t start = (uint64_t)virt_addr & ~0xFFF;
+    uint64_t end = start + count * PAGE_SIZE;
+    uint64_t virt = start;
+    uint64_t phys = (uint64_t)phys_addr & ~0xFFF;
+    
+    while (virt < end) {
+        // Bu sayfa tablosunun kapsadığı son adres
+        uint64_t table_end = (virt + PAGE_SIZE_2M) & ~(PAGE_SIZE_2M - 1);
+        if (table_end > end) {
+            table_end = end;
+        }
+        
+        if (((virt | phys) & (PAGE_SIZE_2M - 1)) == 0 && table_end - virt == PAGE_SIZE_2M) {
+            if (!paging_map_huge_page((void*)phys, (void*)virt, flags)) {
+                goto fail;
+            }
+            phys += PAGE_SIZE_2M;
+            virt = table_end;
+            continue;
+        }
+        
+        uint64_t* pt_entry = (uint64_t*)paging_walk((void*)virt, 1, flags);
+        if (!pt_entry) {
+            goto fail;
+        }
+        
+        uint64_t leaf_flags = PAGE_PRESENT | flags | paging_global_flag(virt);
+        for (; virt < table_end; virt += PAGE_SIZE, phys += PAGE_SIZE, pt_entry++) {
+            if (*pt_entry & PAGE_PRESENT) {
+                terminal_writestring("Hata: Sayfa zaten eslemesi var!\n");
+                goto fail;
+            }
+            *pt_entry = paging_make_entry((void*)phys, leaf_flags);
+        }
+    }
+    
+    // Mevcut olmayan girişler TLB'de tutulmaz; yeni eşlemeler için invlpg gerekmez
+    return virt_addr;
+    
+fail:
+    paging_unmap_range((void*)start, (virt - start) / PAGE_SIZE, 0);
+    return NULL;
+}
+
+// Sanal aralığın eşlemelerini kaldır, istenirse fiziksel sayfaları da serbest bırak
+// Kaldırılan adresler batch'e eklenir, TLB temizliği çağırana kalır
+// batch NULL ise adresler toplanmaz (çağıran zaten tüm TLB'yi temizleyecektir)
+static void paging_unmap_range_batch(void* virt_addr, uint64_t count, int free_frames, tlb_batch_t* batch) {
+    uint64_t virt = (uint64_t)virt_addr & ~0xFFF;
+    uint64_t end = virt + count * PAGE_SIZE;
+    
+    while (virt < end) {
+        uint64_t table_end = (virt + PAGE_SIZE_2M) & ~(PAGE_SIZE_2M - 1);
+        if (table_end > end) {
+            table_end = end;
+        }
+        
+        uint64_t* pd_entry = paging_walk_pd(virt, 0, 0);
+        if (!pd_entry || !(*pd_entry & PAGE_PRESENT)) {
+            virt = table_end;
+            continue;
+        }
+        
+        if (*pd_entry & PAGE_SIZE_BIT) {
+            // Tamamı kapsanan büyük sayfa bölünmeden kaldırılır
+            if (table_end - virt == PAGE_SIZE_2M) {
+                uint64_t phys = *pd_entry & PAGE_ADDR_MASK & ~(PAGE_SIZE_2M - 1);
+                *pd_entry = 0;
+                if (batch) {
+                    tlb_batch_add(batch, virt);
+                }
+                
+                // Tek işlemcide eski TLB girişi kullanılmadan önce temizlenecek
+                if (free_frames) {
+                    pmm_free_pages((void*)phys, HUGE_PAGE_ORDER);
+                }
+                virt = table_end;
+                continue;
+            }
+            
+            if (!paging_split_huge_page(pd_entry, virt)) {
+                break;
+            }
+        }
+        
+        page_table_t* pt = (page_table_t*)phys_to_virt(*pd_entry & PAGE_ADDR_MASK);
+        for (; virt < table_end; virt += PAGE_SIZE) {
+            uint64_t* pt_entry = &pt->entries[(virt >> 12) & 0x1FF];
+            if (!(*pt_entry & PAGE_PRESENT)) {
+                continue;
+            }
+            
+            uint64_t phys = *pt_entry & PAGE_ADDR_MASK;
+            *pt_entry = 0;
+            if (batch) {
+                tlb_batch_add(batch, virt);
+            }
+            
+            if (free_frames) {
+                pmm_free_page((void*)phys);
+            }
+        }
+    }
+    
+}
+
+// TLB geçersiz kılma işlemi sonda tek seferde yapılır
+void paging_unmap_range(void* virt_addr, uint64_t count, int free_frames) {
+    tlb_batch_t batch;
+    batch.count = 0;
+    batch.flush_all = 0;
+    batch.global = 0;
+    
+    paging_unmap_range_batch(virt_addr, count, free_frames, &batch);
+    tlb_batch_flush(&batch);
+}
+
+// Sanal aralığa fiziksel bellek tahsis edip eşle; buddy'den alınabilen en büyük
+// hizalı ardışık bloklar kullanılır ve her biri tek paging_map_range ile eşlenir
+static void* paging_alloc_range(uint64_t virt_addr, uint64_t count, uint64_t flags, uint32_t alloc_flags) {
+    uint64_t i = 0;
+    while (i < count) {
+        uint64_t chunk_addr = virt_addr + i * PAGE_SIZE;
+        
+        // Sanal hizalamaya ve kalan sayfaya sığan en büyük derece (en fazla 2 MB)
+        uint32_t order = HUGE_PAGE_ORDER;
+        while (order > 0 && (((chunk_addr / PAGE_SIZE) & ((1ULL << order) - 1)) || (1ULL << order) > count - i)) {
+            order--;
+        }
+        
+        // Parçalı bellekte büyük blok bulunamazsa küçüğe in
+        void* phys_addr = NULL;
+        while (order > 0 && !(phys_addr = buddy_alloc(order))) {
+            order--;
+        }
+        
+        if (phys_addr) {
+            if (alloc_flags & PAGE_ALLOC_ZERO) {
+                memset(phys_to_virt((uint64_t)phys_addr), 0, PAGE_SIZE << order);
+            }
+        } else {
+            phys_addr = pmm_alloc_page(alloc_flags);
+        }
+        
+        if (!phys_addr) {
+            // Hata durumunda önceki sayfaları serbest bırak
+            paging_unmap_range((void*)virt_addr, i, 1);
+            return NULL;
+        }
+        
+        if (!paging_map_range(phys_addr, (void*)chunk_addr, 1ULL << order, flags)) {
+            pmm_free_pages(phys_addr, order);
+            paging_unmap_range((void*)virt_addr, i, 1);
+            return NULL;
+        }
+        
+        i += 1ULL << order;
+    }
+    
+    return (void*)virt_addr;
+}
+
+// Kernel için tek sayfa tahsis et
+void* kmalloc_page() {
+    return kmalloc_pages(1);
+}
+
+// Kernel için birden çok sayfa tahsis et
+void* kmalloc_pages(uint64_t count) {
+    // Büyük tahsisler (ör. G/Ç tamponları) 2 MB sınırından başlar ki büyük sayfa alsın
+    uint64_t align = count >= PAGES_PER_2M ? PAGE_SIZE_2M : PAGE_SIZE;
+    uint64_t virt_start = vmalloc_reserve(count, align);
+    if (!virt_start) {
+        return NULL;
+    }
+    
+    void* virt_addr = kmalloc_pages_at((void*)virt_start, count, PAGE_ALLOC_ZERO);
+    if (!virt_addr) {
+        vmalloc_release(virt_start, count);
+        return NULL;
+    }
+    
+    return virt_addr;
+}
+
+// Verilen kernel sanal adresine ardışık sayfalar tahsis edip eşle
+void* kmalloc_pages_at(void* virt_addr, uint64_t count, uint32_t alloc_flags) {
+    return paging_alloc_range((uint64_t)virt_addr, count, PAGE_WRITABLE, alloc_flags);
+}
+
+// Kernel sayfasını serbest bırak
+void kfree_page(void* addr) {
+    kfree_pages(addr, 1);
+}
+
+// Kernel sayfalarını serbest bırak
+void kfree_pages(void* addr, uint64_t count) {
+    if (!vmalloc_contains((uint64_t)addr)) {
+        paging_unmap_range(addr, count, 1);
+        return;
+    }
+    
+    // kmalloc_pages alanı: adresler toplanmaz, aralık bekleyen listeye girer ve
+    // yeniden verilmeden önce vmalloc_purge tüm TLB'yi tek seferde temizler
+    paging_unmap_range_batch(addr, count, 1, NULL);
+    vmalloc_release((uint64_t)addr, count);
+}
+
+// Kullanıcı adres alanı oluştur
+void* paging_create_user_address_space() {
+    // Hazır PML4 varsa kullan (kernel yarısı zaten kopyalı)
+    if (pml4_pool_count > 0) {
+        return pml4_pool[--pml4_pool_count];
+    }
+    
+    // Yeni PML4 tablosu oluştur
+    void* pml4_phys = pmm_alloc_page(PAGE_ALLOC_ZERO);
+    if (!pml4_phys) {
+        return NULL;
+    }
+    
+    // Sayfa sahipliği kayıtları bu işaretle doğrulanır (havuzda da kalır)
+    paging_phys_to_page(pml4_phys)->flags |= PG_PML4;
+    
+    // Kernel adres alanı girdilerini kopyala (yüksek sanal adresler)
+    page_table_t* new_pml4 = (page_table_t*)phys_to_virt((uint64_t)pml4_phys);
+    for (int i = 256; i < 512; i++) {
+        new_pml4->entries[i] = vmm.pml4->entries[i];
+    }
+    
+    // CR3'e yazılacak fiziksel adres döndürülür
+    return pml4_phys;
+}
+
+// Kullanıcı yarısındaki (PML4 0-255) tabloları ve çerçeve sahipliklerini bırak
+static void paging_release_user_tables(page_table_t* pml4) {
+    for (int i = 0; i < 256; i++) {
+        if (!(pml4->entries[i] & PAGE_PRESENT)) {
+            continue;
+        }
+        
+        page_table_t* pdpt = (page_table_t*)phys_to_virt(pml4->entries[i] & PAGE_ADDR_MASK);
+        for (int j = 0; j < 512; j++) {
+            if ((pdpt->entries[j] & (PAGE_PRESENT | PAGE_SIZE_BIT)) != PAGE_PRESENT) {
+                continue;
+            }
+            
+            page_table_t* pd = (page_table_t*)phys_to_virt(pdpt->entries[j] & PAGE_ADDR_MASK);
+            for (int k = 0; k < 512; k++) {
+                if (!(pd->entries[k] & PAGE_PRESENT)) {
+                    continue;
+                }
+                
+                // Büyük sayfalar paylaşılmaz (çoğaltılırken bölünür)
+                if (pd->entries[k] & PAGE_SIZE_BIT) {
+                    pmm_free_pages((void*)(pd->entries[k] & PAGE_ADDR_MASK & ~(PAGE_SIZE_2M - 1)), HUGE_PAGE_ORDER);
+                    continue;
+                }
+                
+                page_table_t* pt = (page_table_t*)phys_to_virt(pd->entries[k] & PAGE_ADDR_MASK);
+                for (int l = 0; l < 512; l++) {
+                    if (pt->entries[l] & (PAGE_PRESENT | PAGE_PROTNONE)) {
+                        paging_page_put((void*)(pt->entries[l] & PAGE_ADDR_MASK));
+                    } else if (pt->entries[l] & PAGE_SWAP) {
+                        swap_free(PAGE_SWAP_SLOT(pt->entries[l]));
+                    }
+                }
+                pmm_free_page((void*)(pd->entries[k] & PAGE_ADDR_MASK));
+            }
+            pmm_free_page((void*)(pdpt->entries[j] & PAGE_ADDR_MASK));
+        }
+        pmm_free_page((void*)(pml4->entries[i] & PAGE_ADDR_MASK));
+        pml4->entries[i] = 0;
+    }
+}
+
+// Kullanıcı adres alanını yok et, tüm tablolarını ve çerçevelerini bırak
+// Alt yarısı temizlenen PML4 yeniden kullanılmak üzere havuza döner
+void paging_free_user_address_space(void* pml4) {
+    // Yok edilen adres alanı yüklüyse önce kernel tablosuna geç
+    if ((uint64_t)pml4 == active_pml4) {
+        paging_switch_address_space((void*)&boot_pml4);
+    }
+    
+    // Eski TLB girişleri sayfa sayfa değil, PCID bırakılırken tek seferde temizlenir
+    paging_release_user_tables((page_table_t*)phys_to_virt((uint64_t)pml4));
+    paging_pcid_release(pml4);
+    
+    if (pml4_pool_count < PML4_POOL_SIZE) {
+        pml4_pool[pml4_pool_count++] = pml4;
+    } else {
+        pmm_free_page(pml4);
+    }
+}
+
+// Kullanıcı adres alanını yazınca kopyala olarak çoğalt
+// Sayfa tabloları kopyalanır; yazılabilir sayfalar iki tarafta da salt okunur +
+// PAGE_COW yapılır ve çerçeveler paylaşılır, veri kopyalanmaz
+void* paging_clone_user_address_space(void* src_pml4) {
+    void* dst_phys = paging_create_user_address_space();
+    if (!dst_phys) {
+        return NULL;
+    }
+    
+    page_table_t* src = (page_table_t*)phys_to_virt((uint64_t)src_pml4);
+    page_table_t* dst = (page_table_t*)phys_to_virt((uint64_t)dst_phys);
+    
+    // Büyük sayfa bölme ve TLB geçersiz kılma kaynak adres alanını hedefler
+    page_table_t* original_pml4 = vmm.pml4;
+    vmm.pml4 = src;
+    
+    tlb_batch_t batch;
+    batch.count = 0;
+    batch.flush_all = 0;
+    batch.global = 0;
     
-    // PD girişini kontrol et
-    if (!(pd->entries[pd_index] & PAGE_PRESENT)) {
-        if (!alloc) {
-            return NULL;
+    for (uint64_t i = 0; i < 256; i++) {
+        if (!(src->entries[i] & PAGE_PRESENT)) {
+            continue;
         }
         
-        // Yeni PT tablosu oluştur
-        void* pt_phys = pmm_alloc_page();
-        if (!pt_phys) {
-            return NULL;
+        void* dst_pdpt_phys = pmm_alloc_page(PAGE_ALLOC_ZERO);
+        if (!dst_pdpt_phys) {
+            goto fail;
         }
+        dst->entries[i] = paging_make_entry(dst_pdpt_phys, src->entries[i] & 0xFFF);
         
-        // PD girişini ayarla
-        pd->entries[pd_index] = paging_make_entry(pt_phys, PAGE_PRESENT | PAGE_WRITABLE | flags);
+        page_table_t* src_pdpt = (page_table_t*)phys_to_virt(src->entries[i] & PAGE_ADDR_MASK);
+        page_table_t* dst_pdpt = (page_table_t*)phys_to_virt((uint64_t)dst_pdpt_phys);
+        for (uint64_t j = 0; j < 512; j++) {
+            if ((src_pdpt->entries[j] & (PAGE_PRESENT | PAGE_SIZE_BIT)) != PAGE_PRESENT) {
+                continue;
+            }
+            
+            void* dst_pd_phys = pmm_alloc_page(PAGE_ALLOC_ZERO);
+            if (!dst_pd_phys) {
+                goto fail;
+            }
+            dst_pdpt->entries[j] = paging_make_entry(dst_pd_phys, src_pdpt->entries[j] & 0xFFF);
+            
+            page_table_t* src_pd = (page_table_t*)phys_to_virt(src_pdpt->entries[j] & PAGE_ADDR_MASK);
+            page_table_t* dst_pd = (page_table_t*)phys_to_virt((uint64_t)dst_pd_phys);
+            for (uint64_t k = 0; k < 512; k++) {
+                if (!(src_pd->entries[k] & PAGE_PRESENT)) {
+                    continue;
+                }
+                
+                uint64_t base = (i << 39) | (j << 30) | (k << 21);
+                
+                // Paylaşım 4 KB çerçeveler üzerinden sayılır
+                if ((src_pd->entries[k] & PAGE_SIZE_BIT) && !paging_split_huge_page(&src_pd->entries[k], base)) {
+                    goto fail;
+                }
+                
+                void* dst_pt_phys = pmm_alloc_page(PAGE_ALLOC_ANY);
+                if (!dst_pt_phys) {
+                    goto fail;
+                }
+                dst_pd->entries[k] = paging_make_entry(dst_pt_phys, src_pd->entries[k] & 0xFFF);
+                
+                page_table_t* src_pt = (page_table_t*)phys_to_virt(src_pd->entries[k] & PAGE_ADDR_MASK);
+                page_table_t* dst_pt = (page_table_t*)phys_to_virt((uint64_t)dst_pt_phys);
+                for (uint64_t l = 0; l < 512; l++) {
+                    uint64_t entry = src_pt->entries[l];
+                    if (entry & (PAGE_PRESENT | PAGE_PROTNONE)) {
+                        // Paylaşılan bellek iki tarafta da aynı çerçeveye yazmaya devam eder
+                        if ((entry & PAGE_WRITABLE) && !(entry & PAGE_SHARED)) {
+                            entry = (entry & ~(uint64_t)PAGE_WRITABLE) | PAGE_COW;
+                            src_pt->entries[l] = entry;
+                            tlb_batch_add(&batch, base | (l << 12));
+                        }
+                        paging_page_get((void*)(entry & PAGE_ADDR_MASK));
+                    } else if (entry & PAGE_SWAP) {
+                        // Takastaki sayfanın yuvası paylaşılır, her taraf kendi kopyasını okur
+                        swap_dup(PAGE_SWAP_SLOT(entry));
+                    }
+                    dst_pt->entries[l] = entry;
+                }
+            }
+        }
     }
     
-    // PT tablosunu al
-    page_table_t* pt = (page_table_t*)((pd->entries[pd_index] & 0x000FFFFFFFFFF000));
+    // Kaynakta yazma izni kaldırılan sayfaların eski TLB girişlerini temizle
+    tlb_batch_flush(&batch);
+    vmm.pml4 = original_pml4;
+    return dst_phys;
     
-    // PT girişini kontrol et ve döndür
-    return (void*)&pt->entries[pt_index];
+fail:
+    // Kaynaktaki PAGE_COW işaretleri geçerli kalır; paylaşım bitince ilk yazma izni geri açar
+    tlb_batch_flush(&batch);
+    vmm.pml4 = original_pml4;
+    terminal_writestring("Hata: Adres alani cogaltilamadi!\n");
+    paging_free_user_address_space(dst_phys);
+    return NULL;
 }
 
-// Sayfalama başlatma
-void paging_init(memory_map_entry_t* mmap, uint32_t mmap_count) {
-    // Bellek haritasını tara ve toplam belleği hesapla
-    pmm.total_memory = 0;
-    pmm.free_memory = 0;
-    pmm.used_memory = 0;
-    pmm.reserved_memory = 0;
+// Yazınca kopyala sayfasına yazma hatasını çöz (1 = çözüldü)
+// Tek sahip kalmışsa kopyalamadan yazma izni geri verilir
+int paging_cow_fault(void* user_pml4, void* virt_addr) {
+    page_table_t* original_pml4 = vmm.pml4;
+    vmm.pml4 = (page_table_t*)phys_to_virt((uint64_t)user_pml4);
     
-    for (uint32_t i = 0; i < mmap_count; i++) {
-        // Kullanılabilir bellek mi?
-        if (mmap[i].type == 1) {
-            pmm.total_memory += mmap[i].size;
-            pmm.free_memory += mmap[i].size;
+    void* page = (void*)((uint64_t)virt_addr & ~0xFFF);
+    uint64_t* pt_entry = (uint64_t*)paging_walk(page, 0, 0);
+    int resolved = 0;
+    
+    if (pt_entry && (*pt_entry & (PAGE_PRESENT | PAGE_COW | PAGE_SIZE_BIT)) == (PAGE_PRESENT | PAGE_COW)) {
+        uint64_t phys = *pt_entry & PAGE_ADDR_MASK;
+        uint64_t flags = (*pt_entry & ~(PAGE_ADDR_MASK | PAGE_COW)) | PAGE_WRITABLE;
+        
+        // Ayrılmış çerçeveler (sıfır sayfası, vDSO) sayacı 1 kalsa da paylaşılır, hep kopyalanır
+        page_t* frame = paging_phys_to_page((void*)phys);
+        if (frame && frame->refcount == 1 && !(frame->flags & PG_RESERVED)) {
+            *pt_entry = phys | flags;
+            resolved = 1;
         } else {
-            pmm.reserved_memory += mmap[i].size;
+            // Sıfır sayfasının kopyası havuzdan hazır sıfırlanmış sayfa olarak alınır
+            void* copy = pmm_alloc_page(phys == (uint64_t)zero_page_phys ? PAGE_ALLOC_ZERO : PAGE_ALLOC_ANY);
+            if (copy) {
+                if (phys != (uint64_t)zero_page_phys) {
+                    memcpy(phys_to_virt((uint64_t)copy), phys_to_virt(phys), PAGE_SIZE);
+                }
+                // Kopya bölgesinden yeniden üretilemez, geri kazanımda değişmiş sayılır
+                paging_set_page_owner(copy, user_pml4, page);
+                *pt_entry = (uint64_t)copy | flags | PAGE_DIRTY;
+                paging_page_put((void*)phys);
+                resolved = 1;
+            }
+        }
+        
+        if (resolved) {
+            paging_flush_tlb(page);
         }
     }
     
-    // Bitmap boyutunu hesapla (her bit bir sayfa temsil eder)
-    pmm.bitmap_size = pmm.total_memory / PAGE_SIZE / 8;
-    if (pmm.bitmap_size * 8 * PAGE_SIZE < pmm.total_memory) {
-        pmm.bitmap_size++; // Yuvarla
+    vmm.pml4 = original_pml4;
+    return resolved;
+}
+
+// Adres alanına PCID ata; boş yoksa etkin olmayan birini sırayla geri al
+static uint32_t pcid_assign(uint64_t pml4_phys) {
+    int pcid = pcid_find(pml4_phys);
+    if (pcid >= 0) {
+        return pcid;
     }
     
-    // Bitmap için bellek ayır (kernel sonu ile başlangıç arasında sabit bir yer)
-    pmm.bitmap = (uint8_t*)0x100000; // 1MB
+    for (uint32_t i = 1; i < PCID_COUNT; i++) {
+        if (pcid_owner[i] == 0) {
+            pcid = i;
+            break;
+        }
+    }
     
-    // Bitmap'i temizle (tüm sayfalar boş)
-    memset(pmm.bitmap, 0, pmm.bitmap_size);
+    if (pcid < 0) {
+        if (pcid_next_victim == active_pcid) {
+            pcid_next_victim = pcid_next_victim % (PCID_COUNT - 1) + 1;
+        }
+        pcid = pcid_next_victim;
+        pcid_next_victim = pcid_next_victim % (PCID_COUNT - 1) + 1;
+    }
     
-    // Kernel ve bitmap alanını işaretle (kullanımda)
-    uint64_t kernel_start = 0; // Kernel başlangıç adresi
-    uint64_t kernel_end = 0x400000; // Varsayılan 4MB
-    uint64_t bitmap_end = (uint64_t)pmm.bitmap + pmm.bitmap_size;
+    // Önceki sahibin girişleri kalmış olabilir; ilk yüklemede temizlenir
+    pcid_owner[pcid] = pml4_phys;
+    pcid_stale[pcid] = 1;
+    return pcid;
+}
+
+// Adres alanını değiştir
+void paging_switch_address_space(void* pml4) {
+    uint64_t pml4_phys = (uint64_t)pml4;
     
-    // Bitmap ve kernel alanını tahsis edilmiş olarak işaretle
-    for (uint64_t addr = kernel_start; addr < kernel_end; addr += PAGE_SIZE) {
-        uint64_t bit_index = addr / PAGE_SIZE;
-        pmm.bitmap[bit_index / 8] |= (1 << (bit_index % 8));
+    if (!pcid_enabled) {
+        // CR3 kaydedicisini güncelle
+        asm volatile("mov %0, %%cr3" : : "r" (pml4_phys) : "memory");
+        active_pml4 = pml4_phys;
+        return;
     }
     
-    for (uint64_t addr = (uint64_t)pmm.bitmap; addr < bitmap_end; addr += PAGE_SIZE) {
-        uint64_t bit_index = addr / PAGE_SIZE;
-        pmm.bitmap[bit_index / 8] |= (1 << (bit_index % 8));
-    }
+    uint64_t rflags = irq_save();
     
-    // Bellek istatistiklerini güncelle
-    uint64_t reserved_pages = (kernel_end - kernel_start + bitmap_end - (uint64_t)pmm.bitmap) / PAGE_SIZE;
-    pmm.free_memory -= reserved_pages * PAGE_SIZE;
-    pmm.used_memory += reserved_pages * PAGE_SIZE;
+    // Etiketli CR3: geçerli girişleri olan PCID'ye TLB temizlenmeden geçilir
+    uint32_t pcid = pcid_assign(pml4_phys);
+    uint64_t cr3 = pml4_phys | pcid;
+    if (!pcid_stale[pcid]) {
+        cr3 |= CR3_NOFLUSH;
+    }
+    pcid_stale[pcid] = 0;
     
-    // Geçici PML4 tablosunu kullan
-    vmm.pml4 = (page_table_t*)&boot_pml4;
+    asm volatile("mov %0, %%cr3" : : "r" (cr3) : "memory");
+    active_pml4 = pml4_phys;
+    active_pcid = pcid;
     
-    terminal_writestring("Sayfalama baslatildi. Bellek: ");
-    char buf[32];
-    int_to_string(pmm.total_memory / 1024 / 1024, buf);
-    terminal_writestring(buf);
-    terminal_writestring(" MB\n");
+    irq_restore(rflags);
 }
 
-// Sayfa tahsis et
-void* paging_alloc_page() {
-    return pmm_alloc_page();
+// Yok edilen adres alanının PCID'sini bırak
+void paging_pcid_release(void* pml4) {
+    int pcid = pcid_find((uint64_t)pml4);
+    if (pcid <= 0 || (uint64_t)pml4 == active_pml4) {
+        return; // Kernel ve etkin adres alanı bırakılamaz
+    }
+    
+    pcid_owner[pcid] = 0;
+    
+    // Etiketin tüm girişleri tek komutla ya da sonraki atamada temizlenir
+    if (invpcid_supported) {
+        paging_invpcid(INVPCID_SINGLE_CONTEXT, pcid, 0);
+        pcid_stale[pcid] = 0;
+    } else {
+        pcid_stale[pcid] = 1;
+    }
 }
 
-// Sayfayı serbest bırak
-void paging_free_page(void* addr) {
-    pmm_free_page(addr);
+// Kullanıcı sayfası tahsis et
+void* paging_alloc_user_page(void* user_pml4, void* virt_addr, uint64_t flags) {
+    // Sanal adresin kullanıcı alanında olup olmadığını kontrol et
+    if ((uint64_t)virt_addr >= KERNEL_BASE) {
+        terminal_writestring("Hata: Kullanici sayfasi kernel adres alaninda!\n");
+        return NULL;
+    }
+    
+    // Fiziksel sayfa tahsis et (önceki içerik sızmasın diye sıfırlanmış)
+    void* phys_addr = pmm_alloc_page(PAGE_ALLOC_ZERO);
+    if (!phys_addr) {
+        return NULL;
+    }
+    
+    // Geçici olarak orijinal PML4'ü kaydet
+    page_table_t* original_pml4 = vmm.pml4;
+    
+    // Kullanıcı PML4'ünü aktif hale getir
+    vmm.pml4 = (page_table_t*)phys_to_virt((uint64_t)user_pml4);
+    
+    // Sayfayı eşle; yeni sayfa erişilmiş sayılır, ilk yaşlandırmada etkin kalır
+    void* mapped_addr = paging_map_page(phys_addr, virt_addr, flags | PAGE_USER | PAGE_ACCESSED);
+    
+    // Orijinal PML4'e geri dön
+    vmm.pml4 = original_pml4;
+    
+    if (!mapped_addr) {
+        pmm_free_page(phys_addr);
+        return NULL;
+    }
+    
+    paging_set_page_owner(phys_addr, user_pml4, mapped_addr);
+    return mapped_addr;
 }
 
-// Sanal adrese fiziksel sayfa eşle
-void* paging_map_page(void* phys_addr, void* virt_addr, uint64_t flags) {
-    // Sanal adresi sayfa adresine hizala
-    virt_addr = (void*)((uint64_t)virt_addr & ~0xFFF);
-    
-    // Sayfa tabloları oluştur ve son seviye PT girişini al
-    uint64_t* pt_entry = (uint64_t*)paging_walk(virt_addr, 1, flags);
-    if (!pt_entry) {
+// Kullanıcı sayfasını ortak sıfır çerçevesine salt okunur eşle; writable verilirse
+// sayfa PAGE_COW işaretlenir ve ilk yazmada özel bir sıfır sayfası alır
+void* paging_map_user_zero_page(void* user_pml4, void* virt_addr, int writable) {
+    if ((uint64_t)virt_addr >= KERNEL_BASE || !zero_page_phys) {
         return NULL;
     }
     
-    // Son seviye giriş zaten mevcut mu?
-    if (*pt_entry & PAGE_PRESENT) {
-        terminal_writestring("Hata: Sayfa zaten eslemesi var!\n");
+    page_table_t* original_pml4 = vmm.pml4;
+    vmm.pml4 = (page_table_t*)phys_to_virt((uint64_t)user_pml4);
+    
+    void* mapped_addr = paging_map_page(zero_page_phys, virt_addr, PAGE_USER | (writable ? PAGE_COW : 0));
+    
+    vmm.pml4 = original_pml4;
+    return mapped_addr;
+}
+
+// Var olan çerçeveyi kullanıcı adres alanına eşle, çerçevenin referansı artar
+void* paging_map_user_frame(void* user_pml4, void* virt_addr, void* phys_addr, uint64_t flags) {
+    if ((uint64_t)virt_addr >= KERNEL_BASE) {
         return NULL;
     }
     
-    // Sayfa tablosu girişini ayarla
-    *pt_entry = paging_make_entry(phys_addr, PAGE_PRESENT | flags);
+    page_table_t* original_pml4 = vmm.pml4;
+    vmm.pml4 = (page_table_t*)phys_to_virt((uint64_t)user_pml4);
     
-    // TLB'yi temizle
-    paging_flush_tlb(virt_addr);
+    paging_page_get(phys_addr);
+    void* mapped_addr = paging_map_page(phys_addr, virt_addr, flags | PAGE_USER);
+    if (!mapped_addr) {
+        paging_page_put(phys_addr);
+    }
     
-    return virt_addr;
+    vmm.pml4 = original_pml4;
+    return mapped_addr;
 }
 
-// Sanal adresi eşlemesini kaldır
-void paging_unmap_page(void* virt_addr) {
-    // Sayfa tabloları oluştur ve son seviye PT girişini al (oluşturma)
+// Eşlenmiş kullanıcı sayfasının erişim iznini değiştir (mprotect)
+// Erişimi kapatılan sayfanın girişi mevcut olmaktan çıkar ama çerçevesini tutar
+// (PAGE_PROTNONE); izin geri verilince aynı çerçeve yeniden görünür
+// Özel sayfalar yazınca kopyala olarak açılır: çerçeve paylaşılmıyorsa ilk yazma
+// yalnız izni geri verir, paylaşılıyorsa kopyalar
+void paging_protect_user_page(void* user_pml4, void* virt_addr, int readable, int writable) {
+    page_table_t* original_pml4 = vmm.pml4;
+    vmm.pml4 = (page_table_t*)phys_to_virt((uint64_t)user_pml4);
+    
+    // Büyük sayfanın yalnız bir parçasının izni değişebilsin diye 4 KB girişlere bölünür
     uint64_t* pt_entry = (uint64_t*)paging_walk(virt_addr, 0, 0);
-    if (!pt_entry) {
-        return; // Eşleme yok
+    if (pt_entry && (*pt_entry & (PAGE_PRESENT | PAGE_SIZE_BIT)) == (PAGE_PRESENT | PAGE_SIZE_BIT)) {
+        pt_entry = (uint64_t*)paging_walk(virt_addr, 1, PAGE_USER);
     }
     
-    // Sayfa tablosu girişini temizle
-    *pt_entry = 0;
+    if (pt_entry && (*pt_entry & (PAGE_PRESENT | PAGE_PROTNONE))) {
+        uint64_t entry = *pt_entry & ~(uint64_t)(PAGE_PRESENT | PAGE_PROTNONE | PAGE_WRITABLE | PAGE_COW);
+        if (writable) {
+            entry |= (entry & PAGE_SHARED) ? PAGE_WRITABLE : PAGE_COW;
+        }
+        entry |= readable ? PAGE_PRESENT : PAGE_PROTNONE;
+        
+        if (entry != *pt_entry) {
+            *pt_entry = entry;
+            paging_flush_tlb(virt_addr);
+        }
+    }
     
-    // TLB'yi temizle
-    paging_flush_tlb(virt_addr);
+    vmm.pml4 = original_pml4;
 }
 
-// Sanal adresin karşılık geldiği fiziksel adresi bul
-void* paging_get_physical_address(void* virt_addr) {
-    // Sayfa tabloları oluştur ve son seviye PT girişini al (oluşturma)
+// Sayfanın erişimi kapatılmış mı? (çerçeve girişte tutuluyor)
+int paging_user_protnone(void* user_pml4, void* virt_addr) {
+    page_table_t* original_pml4 = vmm.pml4;
+    vmm.pml4 = (page_table_t*)phys_to_virt((uint64_t)user_pml4);
+    
     uint64_t* pt_entry = (uint64_t*)paging_walk(virt_addr, 0, 0);
-    if (!pt_entry) {
-        return NULL; // Eşleme yok
-    }
+    int protnone = pt_entry && (*pt_entry & (PAGE_PRESENT | PAGE_PROTNONE)) == PAGE_PROTNONE;
     
-    // Fiziksel adres = PT girişinden sayfa adresi + sanal adresin offset
-    return (void*)((*pt_entry & 0x000FFFFFFFFFF000) | ((uint64_t)virt_addr & 0xFFF));
+    vmm.pml4 = original_pml4;
+    return protnone;
 }
 
-// Kernel için tek sayfa tahsis et
-void* kmalloc_page() {
-    // Fiziksel sayfa tahsis et
-    void* phys_addr = pmm_alloc_page();
-    if (!phys_addr) {
-        return NULL;
+// Çerçeve tek sahipli özel kullanıcı sayfası mı? (kayıtlı sahibi bu eşleme)
+static int paging_page_is_private(void* phys_addr, void* user_pml4, void* virt_addr) {
+    page_t* page = paging_phys_to_page(phys_addr);
+    return page && page->refcount == 1 && !(page->flags & PG_RESERVED) && paging_owner_valid(page) &&
+           page->mapping == (uint64_t)user_pml4 && page->index == (uint64_t)virt_addr;
+}
+
+// İki çerçevenin içeriği aynı mı?
+static int paging_frames_equal(void* a_phys, void* b_phys) {
+    uint64_t* a = (uint64_t*)phys_to_virt((uint64_t)a_phys);
+    uint64_t* b = (uint64_t*)phys_to_virt((uint64_t)b_phys);
+    for (uint64_t i = 0; i < PAGE_SIZE / sizeof(uint64_t); i++) {
+        if (a[i] != b[i]) {
+            return 0;
+        }
     }
+    return 1;
+}
+
+// Sayfa birleştirme adayı: paylaşılmamış 4 KB özel eşlemenin çerçevesi, yoksa NULL
+void* paging_user_private_frame(void* user_pml4, void* virt_addr) {
+    uint64_t rflags = irq_save();
     
-    // Kernel adres alanında sanal adres seç
-    static uint64_t kernel_heap = KERNEL_BASE;
-    
-    // Sanal adresi eşle
-    void* virt_addr = paging_map_page(phys_addr, (void*)kernel_heap, PAGE_WRITABLE);
-    if (!virt_addr) {
-        pmm_free_page(phys_addr);
+    // Yıkılan adres alanının PML4'ü buddy'ye dönmüş olabilir; tablolar yürünmez
+    page_t* root = paging_phys_to_page(user_pml4);
+    if (!root || !(root->flags & PG_PML4)) {
+        irq_restore(rflags);
         return NULL;
     }
     
-    // Sonraki tahsis için adres alanını güncelle
-    kernel_heap += PAGE_SIZE;
+    page_table_t* original_pml4 = vmm.pml4;
+    vmm.pml4 = (page_table_t*)phys_to_virt((uint64_t)user_pml4);
     
-    return virt_addr;
+    void* frame = NULL;
+    uint64_t* pt_entry = (uint64_t*)paging_walk(virt_addr, 0, 0);
+    if (pt_entry && (*pt_entry & (PAGE_PRESENT | PAGE_SIZE_BIT | PAGE_SHARED)) == PAGE_PRESENT) {
+        void* phys = (void*)(*pt_entry & PAGE_ADDR_MASK);
+        if (paging_page_is_private(phys, user_pml4, virt_addr)) {
+            frame = phys;
+        }
+    }
+    
+    vmm.pml4 = original_pml4;
+    irq_restore(rflags);
+    return frame;
 }
 
-// Kernel için birden çok sayfa tahsis et
-void* kmalloc_pages(uint64_t count) {
-    // İlk sayfayı tahsis et
-    void* first_page = kmalloc_page();
-    if (!first_page) {
-        return NULL;
+// Özel sayfayı içeriği aynı olan target_phys çerçevesine yönlendir (sayfa birleştirme)
+// Eşleme salt okunur kalır, yazılabilir sayfalar yazınca kopyala olur; target_phys ==
+// phys_addr ise sayfa yalnız dondurulur. Kontrol ve değişim kesmeler kapalıyken yapılır
+int paging_merge_user_page(void* user_pml4, void* virt_addr, void* phys_addr, void* target_phys) {
+    uint64_t rflags = irq_save();
+    
+    // Sahip doğrulanmadan tablolar yürünmez (adres alanı yıkılmış olabilir)
+    if (!paging_page_is_private(phys_addr, user_pml4, virt_addr)) {
+        irq_restore(rflags);
+        return 0;
     }
     
-    // Ardışık sayfaları tahsis et
-    for (uint64_t i = 1; i < count; i++) {
-        void* phys_addr = pmm_alloc_page();
-        if (!phys_addr) {
-            // Hata durumunda önceki sayfaları serbest bırak
-            kfree_pages(first_page, i);
-            return NULL;
+    page_table_t* original_pml4 = vmm.pml4;
+    vmm.pml4 = (page_table_t*)phys_to_virt((uint64_t)user_pml4);
+    
+    int merged = 0;
+    uint64_t* pt_entry = (uint64_t*)paging_walk(virt_addr, 0, 0);
+    if (pt_entry && (*pt_entry & (PAGE_PRESENT | PAGE_SIZE_BIT | PAGE_SHARED)) == PAGE_PRESENT &&
+        (*pt_entry & PAGE_ADDR_MASK) == (uint64_t)phys_addr &&
+        (target_phys == phys_addr || paging_frames_equal(phys_addr, target_phys))) {
+        uint64_t flags = *pt_entry & ~(PAGE_ADDR_MASK | PAGE_WRITABLE);
+        if (*pt_entry & PAGE_WRITABLE) {
+            flags |= PAGE_COW;
         }
         
-        // Sonraki sanal adresi hesapla
-        void* virt_addr = (void*)((uint64_t)first_page + i * PAGE_SIZE);
-        
-        // Sanal adresi eşle
-        if (!paging_map_page(phys_addr, virt_addr, PAGE_WRITABLE)) {
-            pmm_free_page(phys_addr);
-            kfree_pages(first_page, i);
-            return NULL;
+        if (target_phys != phys_addr) {
+            paging_page_get(target_phys);
+        }
+        *pt_entry = (uint64_t)target_phys | flags;
+        paging_flush_tlb(virt_addr);
+        if (target_phys != phys_addr) {
+            paging_page_put(phys_addr);
         }
+        merged = 1;
     }
     
-    return first_page;
+    vmm.pml4 = original_pml4;
+    irq_restore(rflags);
+    return merged;
 }
 
-// Kernel sayfasını serbest bırak
-void kfree_page(void* addr) {
-    // Fiziksel adresi bul
-    void* phys_addr = paging_get_physical_address(addr);
-    if (!phys_addr) {
-        return;
-    }
+// Kullanıcı sayfası takas alanına yazılmış mı?
+int paging_user_swapped(void* user_pml4, void* virt_addr) {
+    page_table_t* original_pml4 = vmm.pml4;
+    vmm.pml4 = (page_table_t*)phys_to_virt((uint64_t)user_pml4);
     
-    // Sanal adresi eşlemesini kaldır
-    paging_unmap_page(addr);
+    uint64_t* pt_entry = (uint64_t*)paging_walk(virt_addr, 0, 0);
+    int swapped = pt_entry && (*pt_entry & (PAGE_PRESENT | PAGE_SWAP)) == PAGE_SWAP;
     
-    // Fiziksel sayfayı serbest bırak
-    pmm_free_page(phys_addr);
+    vmm.pml4 = original_pml4;
+    return swapped;
 }
 
-// Kernel sayfalarını serbest bırak
-void kfree_pages(void* addr, uint64_t count) {
-    for (uint64_t i = 0; i < count; i++) {
-        kfree_page((void*)((uint64_t)addr + i * PAGE_SIZE));
+// Takas alanındaki sayfayı yeni çerçeveye okuyup flags ile eşle (1 = erişim artık geçerli)
+// Yuva okunduktan sonra bırakılır; diskte kopyası kalmayan sayfa değişmiş sayılır
+int paging_swap_in(void* user_pml4, void* virt_addr, uint64_t flags) {
+    void* page = (void*)((uint64_t)virt_addr & ~0xFFF);
+    page_table_t* original_pml4 = vmm.pml4;
+    
+    vmm.pml4 = (page_table_t*)phys_to_virt((uint64_t)user_pml4);
+    uint64_t* pt_entry = (uint64_t*)paging_walk(page, 0, 0);
+    uint64_t entry = pt_entry ? *pt_entry : 0;
+    vmm.pml4 = original_pml4;
+    
+    if ((entry & (PAGE_PRESENT | PAGE_SWAP)) != PAGE_SWAP) {
+        return 0;
     }
-}
-
-// Kullanıcı adres alanı oluştur
-void* paging_create_user_address_space() {
-    // Yeni PML4 tablosu oluştur
-    page_table_t* new_pml4 = (page_table_t*)pmm_alloc_page();
-    if (!new_pml4) {
-        return NULL;
+    
+    void* frame = pmm_alloc_page(PAGE_ALLOC_ANY);
+    if (!frame) {
+        return 0;
+    }
+    if (!swap_read_page(PAGE_SWAP_SLOT(entry), frame)) {
+        pmm_free_page(frame);
+        return 0;
     }
     
-    // PML4 tablosunu temizle
-    memset(new_pml4, 0, PAGE_SIZE);
+    // Okuma sırasında giriş değişmiş olabilir (ör. bölge kaldırıldı); yeniden bakılır
+    uint64_t rflags = irq_save();
+    vmm.pml4 = (page_table_t*)phys_to_virt((uint64_t)user_pml4);
+    pt_entry = (uint64_t*)paging_walk(page, 0, 0);
     
-    // Kernel adres alanı girdilerini kopyala (yüksek sanal adresler)
-    for (int i = 256; i < 512; i++) {
-        new_pml4->entries[i] = vmm.pml4->entries[i];
+    int resolved = 1;
+    if (pt_entry && *pt_entry == entry) {
+        *pt_entry = (uint64_t)frame | flags | PAGE_PRESENT | PAGE_USER | PAGE_ACCESSED | PAGE_DIRTY;
+        swap_free(PAGE_SWAP_SLOT(entry));
+        paging_set_page_owner(frame, user_pml4, page);
+    } else {
+        pmm_free_page(frame);
+        resolved = pt_entry && (*pt_entry & PAGE_PRESENT);
     }
     
-    return new_pml4;
-}
-
-// Adres alanını değiştir
-void paging_switch_address_space(void* pml4) {
-    // CR3 kaydedicisini güncelle
-    asm volatile("mov %0, %%cr3" : : "r" (pml4) : "memory");
+    vmm.pml4 = original_pml4;
+    irq_restore(rflags);
+    return resolved;
 }
 
-// Kullanıcı sayfası tahsis et
-void* paging_alloc_user_page(void* user_pml4, void* virt_addr, uint64_t flags) {
-    // Sanal adresin kullanıcı alanında olup olmadığını kontrol et
-    if ((uint64_t)virt_addr >= KERNEL_BASE) {
+// Kullanıcı alanında ardışık sayfalar tahsis et (sıfırlanmış)
+void* paging_alloc_user_range(void* user_pml4, void* virt_addr, uint64_t count, uint64_t flags) {
+    if ((uint64_t)virt_addr + count * PAGE_SIZE > KERNEL_BASE) {
         terminal_writestring("Hata: Kullanici sayfasi kernel adres alaninda!\n");
         return NULL;
     }
     
-    // Fiziksel sayfa tahsis et
-    void* phys_addr = pmm_alloc_page();
-    if (!phys_addr) {
+    // Geçici olarak kullanıcı PML4'ünü aktif hale getir
+    page_table_t* original_pml4 = vmm.pml4;
+    vmm.pml4 = (page_table_t*)phys_to_virt((uint64_t)user_pml4);
+    
+    void* mapped_addr = paging_alloc_range((uint64_t)virt_addr & ~0xFFF, count, flags | PAGE_USER, PAGE_ALLOC_ZERO);
+    
+    vmm.pml4 = original_pml4;
+    
+    return mapped_addr;
+}
+
+// Kullanıcı alanına 2 MB'lık sıfırlanmış büyük sayfa tahsis et
+void* paging_alloc_user_huge_page(void* user_pml4, void* virt_addr, uint64_t flags) {
+    if ((uint64_t)virt_addr >= KERNEL_BASE) {
+        terminal_writestring("Hata: Kullanici sayfasi kernel adres alaninda!\n");
         return NULL;
     }
     
-    // Geçici olarak orijinal PML4'ü kaydet
+    // Geçici olarak kullanıcı PML4'ünü aktif hale getir
     page_table_t* original_pml4 = vmm.pml4;
+    vmm.pml4 = (page_table_t*)phys_to_virt((uint64_t)user_pml4);
     
-    // Kullanıcı PML4'ünü aktif hale getir
-    vmm.pml4 = (page_table_t*)user_pml4;
+    int ok = paging_alloc_huge_at((uint64_t)virt_addr, flags | PAGE_USER, PAGE_ALLOC_ZERO);
     
-    // Sayfayı eşle
-    void* mapped_addr = paging_map_page(phys_addr, virt_addr, flags | PAGE_USER);
+    vmm.pml4 = original_pml4;
+    
+    return ok ? virt_addr : NULL;
+}
+
+// Kullanıcı adresinin kernelden erişilebilen doğrudan eşleme karşılığı
+void* paging_user_to_kernel(void* user_pml4, void* virt_addr) {
+    page_table_t* original_pml4 = vmm.pml4;
+    vmm.pml4 = (page_table_t*)phys_to_virt((uint64_t)user_pml4);
+    
+    void* phys_addr = paging_get_physical_address(virt_addr);
     
-    // Orijinal PML4'e geri dön
     vmm.pml4 = original_pml4;
     
-    if (!mapped_addr) {
-        pmm_free_page(phys_addr);
-        return NULL;
+    return phys_addr ? phys_to_virt((uint64_t)phys_addr) : NULL;
+}
+
+// Kullanıcı aralığındaki sayfaları kaldır, çerçeve ve takas yuvası referanslarını bırak
+// Her sayfa tablosu bir kez yürünür, TLB temizliği sonda toplu yapılır
+void paging_free_user_range(void* user_pml4, void* virt_addr, uint64_t count) {
+    page_table_t* original_pml4 = vmm.pml4;
+    vmm.pml4 = (page_table_t*)phys_to_virt((uint64_t)user_pml4);
+    
+    tlb_batch_t batch;
+    batch.count = 0;
+    batch.flush_all = 0;
+    batch.global = 0;
+    
+    uint64_t virt = (uint64_t)virt_addr & ~0xFFF;
+    uint64_t end = virt + count * PAGE_SIZE;
+    while (virt < end) {
+        uint64_t table_end = (virt + PAGE_SIZE_2M) & ~(PAGE_SIZE_2M - 1);
+        if (table_end > end) {
+            table_end = end;
+        }
+        
+        uint64_t* pd_entry = paging_walk_pd(virt, 0, 0);
+        if (!pd_entry || !(*pd_entry & PAGE_PRESENT)) {
+            virt = table_end;
+            continue;
+        }
+        
+        if (*pd_entry & PAGE_SIZE_BIT) {
+            // Büyük sayfalar paylaşılmaz; tamamı kapsanan sayfa bölünmeden bırakılır
+            if (table_end - virt == PAGE_SIZE_2M) {
+                uint64_t phys = *pd_entry & PAGE_ADDR_MASK & ~(PAGE_SIZE_2M - 1);
+                *pd_entry = 0;
+                tlb_batch_add(&batch, virt);
+                pmm_free_pages((void*)phys, HUGE_PAGE_ORDER);
+                virt = table_end;
+                continue;
+            }
+            
+            if (!paging_split_huge_page(pd_entry, virt)) {
+                break;
+            }
+        }
+        
+        page_table_t* pt = (page_table_t*)phys_to_virt(*pd_entry & PAGE_ADDR_MASK);
+        for (; virt < table_end; virt += PAGE_SIZE) {
+            uint64_t* pt_entry = &pt->entries[(virt >> 12) & 0x1FF];
+            uint64_t entry = *pt_entry;
+            if (entry & PAGE_PRESENT) {
+                *pt_entry = 0;
+                tlb_batch_add(&batch, virt);
+                paging_page_put((void*)(entry & PAGE_ADDR_MASK));
+            } else if (entry & PAGE_PROTNONE) {
+                // Erişimi kapalı giriş TLB'de bulunmaz, yalnız çerçeve bırakılır
+                *pt_entry = 0;
+                paging_page_put((void*)(entry & PAGE_ADDR_MASK));
+            } else if (entry & PAGE_SWAP) {
+                *pt_entry = 0;
+                swap_free(PAGE_SWAP_SLOT(entry));
+            }
+        }
     }
     
-    return mapped_addr;
+    tlb_batch_flush(&batch);
+    vmm.pml4 = original_pml4;
 }
 
 // Kullanıcı sayfasını serbest bırak
@@ -421,17 +2491,30 @@ void paging_free_user_page(void* user_pml4, void* virt_addr) {
     page_table_t* original_pml4 = vmm.pml4;
     
     // Kullanıcı PML4'ünü aktif hale getir
-    vmm.pml4 = (page_table_t*)user_pml4;
+    vmm.pml4 = (page_table_t*)phys_to_virt((uint64_t)user_pml4);
     
     // Fiziksel adresi bul
     void* phys_addr = paging_get_physical_address(virt_addr);
     
+    // Takas alanındaki sayfanın yuvası bırakılır
+    uint64_t* pt_entry = (uint64_t*)paging_walk(virt_addr, 0, 0);
+    if (pt_entry && (*pt_entry & (PAGE_PRESENT | PAGE_SWAP)) == PAGE_SWAP) {
+        swap_free(PAGE_SWAP_SLOT(*pt_entry));
+        *pt_entry = 0;
+    }
+    
+    // Erişimi kapalı sayfanın çerçevesi mevcut olmayan girişte durur
+    if (pt_entry && (*pt_entry & (PAGE_PRESENT | PAGE_PROTNONE)) == PAGE_PROTNONE) {
+        phys_addr = (void*)(*pt_entry & PAGE_ADDR_MASK);
+        *pt_entry = 0;
+    }
+    
     // Sayfayı eşlemesini kaldır
     paging_unmap_page(virt_addr);
     
-    // Fiziksel sayfayı serbest bırak
+    // Çerçeve paylaşılıyor olabilir, son referansta serbest kalır
     if (phys_addr) {
-        pmm_free_page(phys_addr);
+        paging_page_put(phys_addr);
     }
     
     // Orijinal PML4'e geri dön
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include "numa.h"
 
 // Sayfa hizalama sabiti
 #define PAGE_SIZE 4096
@@ -15,10 +16,38 @@
 #define PAGE_CACHE_DISABLE 0x10    // Önbellek devre dışı
 #define PAGE_ACCESSED   0x20       // Sayfaya erişildi
 #define PAGE_DIRTY      0x40       // Sayfa değiştirildi
-#define PAGE_SIZE_BIT   0x80       // Huge page (1 GB)
+#define PAGE_SIZE_BIT   0x80       // Büyük sayfa (PDPT'de 1 GB, PD'de 2 MB)
 #define PAGE_GLOBAL     0x100      // Global sayfa
+#define PAGE_COW        0x200      // Yazınca kopyala (yazılabilir bit geçici olarak kapalı)
+#define PAGE_SHARED     0x400      // Paylaşılan bellek: çoğaltmada yazınca kopyalaya dönmez
+#define PAGE_SWAP       0x800      // Mevcut olmayan giriş: sayfa takas alanında
+#define PAGE_PROTNONE   (1ULL << 52) // Mevcut olmayan giriş: çerçeve eşli kalır, erişim kapalı (PROT_NONE)
+
+// Takas girişinde yuva numarası adres bitlerinde tutulur
+#define PAGE_SWAP_ENTRY(slot) (((uint64_t)(slot) << 12) | PAGE_SWAP)
+#define PAGE_SWAP_SLOT(entry) (((entry) & PAGE_ADDR_MASK) >> 12)
+
+// Sayfa tablosu girişindeki fiziksel adres bitleri (12-51)
+#define PAGE_ADDR_MASK  0x000FFFFFFFFFF000
+
+// Büyük sayfa boyutları
+#define PAGE_SIZE_2M    0x200000ULL
+#define PAGE_SIZE_1G    0x40000000ULL
+#define PAGE_SIZE_512G  0x8000000000ULL
+
+// 2 MB sayfa = 512 adet 4 KB sayfa = buddy derecesi 9
+#define PAGES_PER_2M    512
+#define HUGE_PAGE_ORDER 9
+
+// Fiziksel sayfa tahsis bayrakları
+#define PAGE_ALLOC_ANY  0x0        // İçerik önemsiz
+#define PAGE_ALLOC_ZERO 0x1        // Sıfırlanmış sayfa gerekli
 
 // Sanal adres alanı bölümleri
+#define PHYS_MAP_BASE   0xFFFF800000000000 // Tüm fiziksel belleğin doğrudan eşlemesi
+#define PHYS_MAP_SIZE   0x0000400000000000 // Doğrudan eşleme boyutu (64 TB)
+#define KERNEL_HEAP_START 0xFFFFC00000000000 // Kernel heap bölgesi (kmalloc)
+#define KERNEL_HEAP_END   0xFFFFC08000000000 // Heap üst sınırı (512 GB)
 #define KERNEL_BASE     0xFFFFFFFF80000000  // Kernelin başlangıç sanal adresi
 #define USER_BASE       0x0000000000400000  // Kullanıcı alanının başlangıcı
 #define USER_STACK_TOP  0x00007FFFFFFFFFFF  // Kullanıcı yığınının tepesi
@@ -28,6 +57,13 @@ typedef struct {
     uint64_t entries[512];
 } page_table_t;
 
+// Bellek haritası girdi türleri (multiboot ile aynı)
+#define MMAP_TYPE_AVAILABLE        1   // Kullanılabilir RAM
+#define MMAP_TYPE_RESERVED         2   // Ayrılmış
+#define MMAP_TYPE_ACPI_RECLAIMABLE 3   // ACPI tabloları
+#define MMAP_TYPE_ACPI_NVS         4   // ACPI NVS
+#define MMAP_TYPE_BAD              5   // Hatalı bellek
+
 // Fiziksel bellek haritası
 typedef struct {
     uint64_t start;              // Başlangıç adresi
@@ -35,6 +71,70 @@ typedef struct {
     uint8_t  type;               // Bellek türü
 } memory_map_entry_t;
 
+// Buddy ayırıcının en yüksek derecesi (2^10 sayfa = 4 MB bloklar)
+#define PMM_MAX_ORDER 11
+
+// En fazla kesintisiz fiziksel bellek bölgesi
+#define PMM_MAX_REGIONS 32
+
+// 1 MB altı fiziksel bellek ayırıcıya verilmez
+#define PMM_LOW_MEMORY_END 0x100000
+
+// DMA havuzu: açılışta 4 GB altında ayrılan kesintisiz bölge (en fazla 4 MB,
+// küçük bellekte toplam sayfanın en fazla 1/PMM_DMA_POOL_DIVISOR'ı)
+#define PMM_DMA_POOL_PAGES   1024
+#define PMM_DMA_POOL_DIVISOR 16
+#define PMM_DMA_LIMIT        0x100000000ULL
+
+// boot.asm'in kimlik eşlediği sınır (1 GB); doğrudan eşleme tabloları bunun altında olmalı
+#define BOOT_IDENTITY_LIMIT 0x40000000
+
+// Sayfa çerçevesi bayrakları
+#define PG_RESERVED  0x01        // Kernel imajı/meta veri, serbest bırakılmaz
+#define PG_BUDDY     0x02        // Serbest buddy bloğunun başı (order geçerli)
+#define PG_ZERO      0x04        // Sıfır havuzunda, içeriği sıfır
+#define PG_USER      0x08        // Kullanıcı sayfası (mapping/index geçerli)
+#define PG_PML4      0x10        // Kullanıcı adres alanının PML4 tablosu
+#define PG_LRU       0x20        // LRU listelerinden birinde
+#define PG_ACTIVE    0x40        // Etkin listede (yoksa etkin olmayan listede)
+
+// Sayfa çerçevesi tanımlayıcısı (PFN ile dizinlenir)
+typedef struct page {
+    uint32_t refcount;           // Sahip sayısı (0 = boş)
+    uint16_t flags;              // PG_* bayrakları
+    uint8_t order;               // Serbest blok başında blok derecesi
+    uint8_t reserved;
+    uint64_t mapping;            // Sahip adres alanı (kullanıcı PML4'ü, 0 = yok)
+    uint64_t index;              // Sahip içindeki sanal adres
+    struct page* next;           // Liste bağları (ör. LRU)
+    struct page* prev;
+} page_t;
+
+// Kesintisiz kullanılabilir fiziksel bellek bölgesi ve meta verisi
+typedef struct {
+    uint64_t start_pfn;          // İlk sayfa çerçevesi
+    uint64_t page_count;         // Bölgedeki sayfa sayısı
+    page_t* pages;               // Bölgedeki her çerçevenin tanımlayıcısı
+    uint32_t node;               // Bölgenin NUMA düğümü (bölge düğüm sınırını aşmaz)
+} pmm_region_t;
+
+// Serbest buddy bloğu bağları (bloğun ilk sayfasında tutulur)
+typedef struct pmm_free_block {
+    struct pmm_free_block* next;
+    struct pmm_free_block* prev;
+} pmm_free_block_t;
+
+// NUMA düğümünün buddy listeleri ve uzaklığa göre yedek düğüm sırası
+typedef struct {
+    pmm_free_block_t* free_lists[PMM_MAX_ORDER]; // Derece başına serbest bloklar
+    uint64_t free_blocks[PMM_MAX_ORDER];         // Derece başına serbest blok sayısı
+    uint64_t total_pages;        // Düğümdeki sayfa sayısı
+    uint64_t free_pages;         // Buddy listelerindeki sayfa sayısı
+    uint32_t fallback[NUMA_MAX_NODES]; // Denenecek düğümler (ilki kendisi, sonra en yakınlar)
+    uint64_t local_allocs;       // Bu düğümdeki işlemci için kendi belleğinden yapılan tahsis
+    uint64_t remote_allocs;      // Bu düğümdeki işlemci için başka düğümden yapılan tahsis
+} pmm_node_t;
+
 // Fiziksel bellek yöneticisi
 typedef struct {
     uint64_t total_memory;       // Toplam bellek (bayt)
@@ -42,34 +142,141 @@ typedef struct {
     uint64_t used_memory;        // Kullanılan bellek (bayt)
     uint64_t reserved_memory;    // Ayrılmış bellek (bayt)
     
-    uint64_t bitmap_size;        // Bitmap boyutu (bayt)
-    uint8_t* bitmap;             // Bellek tahsis bitmap'i
+    // Bölgeler (başlangıç adresine göre sıralı)
+    pmm_region_t regions[PMM_MAX_REGIONS];
+    uint32_t region_count;       // Bölge sayısı
+    uint64_t metadata_size;      // Tüm bölgelerin meta veri boyutu (bayt)
+    uint64_t dma_pool_start;     // DMA havuzunun fiziksel adresi (0 = yok)
+    uint64_t dma_pool_pages;     // DMA havuzundaki sayfa sayısı
+    
+    // Buddy ayırıcı (düğüm başına listeler)
+    uint64_t total_pages;        // Yönetilen sayfa sayısı
+    pmm_node_t nodes[NUMA_MAX_NODES];
+    uint32_t node_count;         // NUMA düğümü sayısı (SRAT yoksa 1)
+    
+    // Önceden sıfırlanmış sayfa havuzu
+    uint64_t zero_pool_count;    // Havuzdaki sayfa sayısı
+    uint64_t zero_pool_hits;     // Havuzdan karşılanan sıfır sayfa istekleri
+    uint64_t zero_pool_misses;   // Eşzamanlı sıfırlanan sayfa istekleri
+    
+    // Sayfa geri kazanımı (serbest sayfa eşikleri)
+    uint64_t watermark_min;      // Altında tahsis eden de geri kazanım yapar
+    uint64_t watermark_low;      // Altında boşta döngüsü geri kazanıma başlar
+    uint64_t watermark_high;     // Geri kazanım bu seviyeye kadar sürer
+    uint64_t lru_active;         // Etkin listedeki sayfa sayısı
+    uint64_t lru_inactive;       // Etkin olmayan listedeki sayfa sayısı
+    uint64_t reclaimed_pages;    // Geri kazanılan toplam sayfa
+    uint64_t pressure_events;    // Düşük bellek bildirimi sayısı
 } physical_memory_manager_t;
 
+// Serbest sayfa eşikleri (toplam sayfanın payı, en az PMM_WATERMARK_MIN_PAGES)
+#define PMM_WATERMARK_DIVISOR   128
+#define PMM_WATERMARK_MIN_PAGES 16
+
+// Bir geri kazanım turunda LRU listelerinde incelenen en fazla sayfa
+#define LRU_SCAN_BATCH 64
+
+// Düşük bellek bildirim seviyeleri
+#define MEM_PRESSURE_LOW      1    // Serbest bellek düşük eşiğin altında
+#define MEM_PRESSURE_CRITICAL 2    // Tahsis geri kazanıma rağmen karşılanamıyor
+
+// Düşük bellek bildirimi; geri verilen sayfa sayısını döndürür
+typedef uint64_t (*mem_pressure_callback_t)(uint32_t level);
+#define MEM_PRESSURE_MAX_CALLBACKS 8
+
+// Toplu TLB geçersiz kılma; bundan fazla sayfada CR3 yeniden yüklenir
+#define TLB_BATCH_MAX 32
+
+typedef struct {
+    uint64_t addrs[TLB_BATCH_MAX]; // invlpg yapılacak sanal adresler
+    uint32_t count;                // Biriken adres sayısı
+    int flush_all;                 // Eşik aşıldı, tüm TLB temizlenecek
+    int global;                    // Kernel (global) adresi içeriyor
+} tlb_batch_t;
+
+// CR3/CR4 bitleri
+#define CR3_PCID_MASK 0xFFF        // CR3'teki PCID alanı
+#define CR3_NOFLUSH   (1ULL << 63) // CR3 yazarken PCID'nin TLB girişlerini koru
+#define CR0_WP        (1 << 16)    // Kernel de salt okunur sayfalara yazamaz
+#define CR4_PGE       (1 << 7)     // Global sayfalar etkin
+#define CR4_PCIDE     (1 << 17)    // PCID etkin
+
+// İşlem bağlamı tanımlayıcıları (PCID); 0 kernel adres alanına ayrılmıştır
+#define PCID_COUNT 64
+
+// INVPCID türleri
+#define INVPCID_ADDRESS        0   // Tek PCID'de tek adres
+#define INVPCID_SINGLE_CONTEXT 1   // Tek PCID'nin global olmayan girişleri
+#define INVPCID_ALL_GLOBAL     2   // Tüm PCID'ler, global girişler dahil
+
 // Sanal bellek yöneticisi
 typedef struct {
     page_table_t* pml4;          // Üst seviye sayfa tablosu (CR3)
 } virtual_memory_manager_t;
 
+// Fiziksel adresi doğrudan eşlemedeki sanal adrese çevir
+static inline void* phys_to_virt(uint64_t phys) {
+    return (void*)(phys + PHYS_MAP_BASE);
+}
+
+// Doğrudan eşlemedeki sanal adresi fiziksel adrese çevir
+static inline uint64_t virt_to_phys(void* virt) {
+    return (uint64_t)virt - PHYS_MAP_BASE;
+}
+
 // Sayfalama işlevleri
 void paging_init(memory_map_entry_t* mmap, uint32_t mmap_count);
-void* paging_alloc_page();
+void* paging_alloc_page(uint32_t alloc_flags);
 void paging_free_page(void* addr);
+void* paging_alloc_pages(uint32_t order);
+void paging_free_pages(void* addr, uint32_t order);
+void paging_page_get(void* phys_addr);
+void paging_page_put(void* phys_addr);
+uint32_t paging_page_refcount(void* phys_addr);
+page_t* paging_phys_to_page(void* phys_addr);
+void* paging_page_to_phys(page_t* page);
+void paging_refill_zero_pool();
+void paging_balance();
+uint64_t paging_reclaim(uint64_t target, uint32_t level);
+int paging_register_pressure_callback(mem_pressure_callback_t callback);
+const physical_memory_manager_t* paging_get_pmm_info();
 void* paging_map_page(void* phys_addr, void* virt_addr, uint64_t flags);
 void paging_unmap_page(void* virt_addr);
+void* paging_map_range(void* phys_addr, void* virt_addr, uint64_t count, uint64_t flags);
+void paging_unmap_range(void* virt_addr, uint64_t count, int free_frames);
 void* paging_get_physical_address(void* virt_addr);
+uint64_t paging_get_page_size(void* virt_addr);
+void* paging_map_huge_page(void* phys_addr, void* virt_addr, uint64_t flags);
+void* paging_unmap_huge_page(void* virt_addr);
 
 // Kernel bellek tahsisi
 void* kmalloc_page();
 void* kmalloc_pages(uint64_t count);
+void* kmalloc_pages_at(void* virt_addr, uint64_t count, uint32_t alloc_flags);
 void kfree_page(void* addr);
 void kfree_pages(void* addr, uint64_t count);
 
 // Kullanıcı bellek alanı işlevleri
 void* paging_create_user_address_space();
+void* paging_clone_user_address_space(void* src_pml4);
+void paging_free_user_address_space(void* pml4);
+int paging_cow_fault(void* user_pml4, void* virt_addr);
 void paging_switch_address_space(void* pml4);
+void paging_pcid_release(void* pml4);
 void* paging_alloc_user_page(void* user_pml4, void* virt_addr, uint64_t flags);
+void* paging_map_user_zero_page(void* user_pml4, void* virt_addr, int writable);
+void* paging_map_user_frame(void* user_pml4, void* virt_addr, void* phys_addr, uint64_t flags);
+void paging_protect_user_page(void* user_pml4, void* virt_addr, int readable, int writable);
+int paging_user_protnone(void* user_pml4, void* virt_addr);
+void* paging_user_private_frame(void* user_pml4, void* virt_addr);
+int paging_merge_user_page(void* user_pml4, void* virt_addr, void* phys_addr, void* target_phys);
+int paging_user_swapped(void* user_pml4, void* virt_addr);
+int paging_swap_in(void* user_pml4, void* virt_addr, uint64_t flags);
+void* paging_alloc_user_huge_page(void* user_pml4, void* virt_addr, uint64_t flags);
+void* paging_alloc_user_range(void* user_pml4, void* virt_addr, uint64_t count, uint64_t flags);
+void* paging_user_to_kernel(void* user_pml4, void* virt_addr);
 void paging_free_user_page(void* user_pml4, void* virt_addr);
+void paging_free_user_range(void* user_pml4, void* virt_addr, uint64_t count);
 
 // TLB temizleme
 void paging_flush_tlb(void* addr);
@@ -1,16 +1,21 @@
 #include "kernel.h"
 #include "pipe.h"
 #include "process.h"
+#include "slab.h"
 
-// Pipe dizisi
+// Pipe dizisi (pipe yapıları önbellekten tahsis edilir)
 #define MAX_PIPES 64
-static pipe_t pipes[MAX_PIPES];
+static pipe_t* pipes[MAX_PIPES];
 static uint64_t next_pipe_id = 1;
+static kmem_cache_t* pipe_cache = NULL;
 
 // Pipe yönetimini başlat
 int pipe_init() {
-    // Tüm pipe yapılarını sıfırla
+    // Tüm pipe yuvalarını sıfırla
     memset(pipes, 0, sizeof(pipes));
+    
+    // Pipe yapıları için önbelleği oluştur
+    pipe_cache = kmem_cache_create("pipe", sizeof(pipe_t), 8, NULL);
     terminal_writestring("Pipe yonetimi baslatildi.\n");
     return PIPE_SUCCESS;
 }
@@ -20,7 +25,7 @@ int pipe_create(uint64_t* read_fd, uint64_t* write_fd) {
     // Boş bir pipe bul
     int pipe_index = -1;
     for (int i = 0; i < MAX_PIPES; i++) {
-        if (pipes[i].id == 0) {
+        if (pipes[i] == NULL) {
             pipe_index = i;
             break;
         }
@@ -31,13 +36,21 @@ int pipe_create(uint64_t* read_fd, uint64_t* write_fd) {
         return PIPE_ERROR_FULL;
     }
     
+    // Pipe yapısını önbellekten al
+    pipe_t* pipe = (pipe_t*)kmem_cache_alloc(pipe_cache);
+    if (!pipe) {
+        return PIPE_ERROR_FULL;
+    }
+    pipes[pipe_index] = pipe;
+    
     // Pipe yapısını ayarla
-    pipe_t* pipe = &pipes[pipe_index];
     pipe->id = next_pipe_id++;
     pipe->read_pos = 0;
     pipe->write_pos = 0;
     pipe->data_size = 0;
     pipe->flags = 0;
+    pipe->reader_pid = 0;
+    pipe->writer_pid = 0;
     pipe->reader_open = 1;
     pipe->writer_open = 1;
     
@@ -62,8 +75,8 @@ pipe_t* pipe_get_by_fd(uint64_t fd) {
     
     // Tüm pipe'ları dolaş
     for (int i = 0; i < MAX_PIPES; i++) {
-        if (pipes[i].id == pipe_id) {
-            return &pipes[i];
+        if (pipes[i] && pipes[i]->id == pipe_id) {
+            return pipes[i];
         }
     }
     
@@ -88,7 +101,14 @@ int pipe_close(uint64_t fd) {
     
     // Her iki uç da kapalıysa pipe'ı tamamen kaldır
     if (!pipe->reader_open && !pipe->writer_open) {
-        pipe->id = 0; // Pipe'ı serbest bırak
+        // Yuvayı boşalt ve yapıyı önbelleğe geri ver
+        for (int i = 0; i < MAX_PIPES; i++) {
+            if (pipes[i] == pipe) {
+                pipes[i] = NULL;
+                break;
+            }
+        }
+        kmem_cache_free(pipe_cache, pipe);
     }
     
     return PIPE_SUCCESS;
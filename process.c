@@ -2,17 +2,26 @@
 #include "process.h"
 #include "signals.h"
 #include "timer.h"
+#include "slab.h"
+#include "paging.h"
+#include "vdso.h"
 
 // Süreç tablosu ve mevcut süreç
 static process_t processes[MAX_PROCESSES];
 static uint64_t current_process_index = 0;
 static uint64_t next_pid = 1;
 
+// Süreç kernel yığınları için nesne önbelleği
+static kmem_cache_t* stack_cache = NULL;
+
 // Süreç yönetimini başlat
 void init_processes() {
     // Süreç tablosunu temizle
     memset(processes, 0, sizeof(processes));
     
+    // Kernel yığınları için önbelleği oluştur
+    stack_cache = kmem_cache_create("process_stack", PROCESS_STACK_SIZE, 16, NULL);
+    
     terminal_writestring("Surec yonetimi baslatildi.\n");
 }
 
@@ -51,9 +60,20 @@ uint64_t create_process(const char* name, uint64_t entry_point, uint64_t parent_
     memset(&process->registers, 0, sizeof(registers_t));
     process->registers.rip = entry_point;
     
+    // Kullanıcı adres alanı yükleyici tarafından kurulur
+    process->page_directory = 0;
+    vma_map_init(&process->vmas);
+    process->brk_start = 0;
+    process->brk = 0;
+    
     // Süreç yığınını oluştur (4KB)
-    process->stack_size = 4096;
-    process->stack = kmalloc(process->stack_size);
+    process->stack_size = PROCESS_STACK_SIZE;
+    process->stack = kmem_cache_alloc(stack_cache);
+    if (!process->stack) {
+        terminal_writestring("Hata: Surec yigini ayrilamadi!\n");
+        process->pid = 0;
+        return 0;
+    }
     process->registers.rsp = (uint64_t)process->stack + process->stack_size;
     
     // Başlangıç zamanını ayarla
@@ -275,10 +295,17 @@ void exit_process(uint64_t pid, uint64_t exit_code) {
     
     // Süreç kaynakları temizle
     if (process->stack) {
-        kfree(process->stack);
+        kmem_cache_free(stack_cache, process->stack);
         process->stack = NULL;
     }
     
+    // Sanal bellek bölgelerini ve adres alanını bırak
+    vma_free_all(&process->vmas);
+    if (process->page_directory) {
+        paging_free_user_address_space((void*)process->page_directory);
+        process->page_directory = 0;
+    }
+    
     // Sinyal yığınını temizle
     if (process->signal_stack) {
         kfree(process->signal_stack);
@@ -289,6 +316,7 @@ void exit_process(uint64_t pid, uint64_t exit_code) {
     for (int i = 0; i < MAX_PROCESSES; i++) {
         if (processes[i].pid != 0 && processes[i].parent_pid == pid) {
             processes[i].parent_pid = 1; // init sürecine bağla
+            vdso_update_process(&processes[i]);
         }
     }
     
@@ -308,6 +336,27 @@ void exit_process(uint64_t pid, uint64_t exit_code) {
     schedule();
 }
 
+// Hiç çalışmamış süreci kaynaklarıyla sil ve yuvasını boşalt (başarısız fork)
+void release_process(uint64_t pid) {
+    process_t* process = get_process(pid);
+    if (!process) {
+        return;
+    }
+    
+    if (process->stack) {
+        kmem_cache_free(stack_cache, process->stack);
+        process->stack = NULL;
+    }
+    
+    vma_free_all(&process->vmas);
+    if (process->page_directory) {
+        paging_free_user_address_space((void*)process->page_directory);
+        process->page_directory = 0;
+    }
+    
+    process->pid = 0;
+}
+
 // Süreci durdur (SIGSTOP benzeri)
 void stop_process(uint64_t pid) {
     // Süreci bul
@@ -381,6 +430,14 @@ process_t* get_process(uint64_t pid) {
     return NULL;
 }
 
+// Süreç tablosundaki yuvayı al (boş yuvada NULL)
+process_t* get_process_slot(int index) {
+    if (index < 0 || index >= MAX_PROCESSES || processes[index].pid == 0) {
+        return NULL;
+    }
+    return &processes[index];
+}
+
 // Süreç grubunu ayarla
 int set_process_group(uint64_t pid, uint64_t pgid) {
     process_t* process = get_process(pid);
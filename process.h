@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include "signals.h"
+#include "vma.h"
 
 // Süreç durumları
 #define PROCESS_STATE_READY    0   // Çalışmaya hazır
@@ -15,6 +16,9 @@
 // Maksimum süreç sayısı
 #define MAX_PROCESSES 64
 
+// Süreç kernel yığını boyutu
+#define PROCESS_STACK_SIZE 4096
+
 // Kaydedici durumu
 typedef struct {
     uint64_t rax, rbx, rcx, rdx;
@@ -39,6 +43,9 @@ typedef struct {
     
     // Bellek bilgisi
     uint64_t page_directory;   // Sayfa dizini
+    vm_map_t vmas;             // Sanal bellek bölgeleri
+    uint64_t brk_start;        // Yığın (heap) başlangıcı: yüklenen görüntünün sonu
+    uint64_t brk;              // Geçerli program sonu (brk)
     void* stack;               // Yığın işaretçisi
     uint64_t stack_size;       // Yığın boyutu
     
@@ -75,10 +82,12 @@ void block_process(uint64_t pid);
 void unblock_process(uint64_t pid);
 void sleep_process(uint64_t pid, uint64_t ms);
 void exit_process(uint64_t pid, uint64_t exit_code);
+void release_process(uint64_t pid);
 void stop_process(uint64_t pid);
 void continue_process(uint64_t pid);
 process_t* get_current_process();
 process_t* get_process(uint64_t pid);
+process_t* get_process_slot(int index);
 int set_process_group(uint64_t pid, uint64_t pgid);
 int create_session(void);
 int is_orphaned_process_group(uint64_t pgid);
@@ -3,12 +3,30 @@
 #include "keyboard.h"
 #include "coreutils.h"
 #include "filesystem.h"
+#include "slab.h"
+
+// Geçmiş komut dizgileri için nesne önbelleği
+static kmem_cache_t* history_cache = NULL;
+
+// Komutu geçmiş önbelleğinden alınan bir nesneye kopyala
+static char* shell_history_dup(const char* command) {
+    char* entry = (char*)kmem_cache_alloc(history_cache);
+    if (entry) {
+        memcpy(entry, command, strlen(command) + 1);
+    }
+    return entry;
+}
 
 // Kabuk başlatma
 void shell_init(shell_t* shell) {
     // Yapıyı sıfırla
     memset(shell, 0, sizeof(shell_t));
     
+    // Geçmiş önbelleğini oluştur (komutlar tampon boyutunu aşamaz)
+    if (!history_cache) {
+        history_cache = kmem_cache_create("shell_history", SHELL_BUFFER_SIZE, 8, NULL);
+    }
+    
     // Çalışma dizinini ayarla
     fs_getcwd(shell->cwd, sizeof(shell->cwd));
     
@@ -176,7 +194,7 @@ void shell_add_to_history(shell_t* shell, const char* command) {
     
     // Geçmiş dolu ise, en eskiyi sil
     if (shell->history_count == SHELL_HISTORY_SIZE) {
-        free(shell->history[0]);
+        kmem_cache_free(history_cache, shell->history[0]);
         
         // Diğer öğeleri kaydır
         for (int i = 0; i < shell->history_count - 1; i++) {
@@ -187,7 +205,11 @@ void shell_add_to_history(shell_t* shell, const char* command) {
     }
     
     // Yeni komutu ekle
-    shell->history[shell->history_count] = strdup(command);
+    char* entry = shell_history_dup(command);
+    if (!entry) {
+        return;
+    }
+    shell->history[shell->history_count] = entry;
     shell->history_count++;
 }
 
@@ -355,7 +377,7 @@ void shell_cleanup(shell_t* shell) {
     // Geçmiş komutları temizle
     for (int i = 0; i < shell->history_count; i++) {
         if (shell->history[i]) {
-            kfree(shell->history[i]);
+            kmem_cache_free(history_cache, shell->history[i]);
             shell->history[i] = NULL;
         }
     }
@@ -0,0 +1,279 @@
+#include "kernel.h"
+#include "shm.h"
+#include "process.h"
+#include "paging.h"
+#include "vma.h"
+#include "slab.h"
+
+// Segment dizisi (segment yapıları önbellekten tahsis edilir)
+static shm_segment_t* segments[SHM_MAX_SEGMENTS];
+static uint64_t next_shm_id = 1;
+static kmem_cache_t* shm_cache = NULL;
+
+// Segment adlarını karşılaştır
+static int shm_name_equal(const char* a, const char* b) {
+    for (int i = 0; i < SHM_NAME_MAX; i++) {
+        if (a[i] != b[i]) {
+            return 0;
+        }
+        if (a[i] == '\0') {
+            return 1;
+        }
+    }
+    return 1;
+}
+
+// Segmenti kimliğinden bul
+static shm_segment_t* shm_find_by_id(uint64_t id) {
+    for (int i = 0; i < SHM_MAX_SEGMENTS; i++) {
+        if (segments[i] && segments[i]->id == id) {
+            return segments[i];
+        }
+    }
+    return NULL;
+}
+
+// Silinmemiş segmenti adından bul
+static shm_segment_t* shm_find_by_name(const char* name) {
+    for (int i = 0; i < SHM_MAX_SEGMENTS; i++) {
+        if (segments[i] && !segments[i]->removed && shm_name_equal(segments[i]->name, name)) {
+            return segments[i];
+        }
+    }
+    return NULL;
+}
+
+// Segmentin çerçevelerini ve yuvasını serbest bırak
+// Eşlemelerde kalan çerçeveler son referans düşene kadar yaşar
+static void shm_destroy(shm_segment_t* segment) {
+    for (uint64_t i = 0; i < segment->page_count; i++) {
+        if (segment->frames[i]) {
+            paging_page_put(segment->frames[i]);
+        }
+    }
+    kfree(segment->frames);
+
+    for (int i = 0; i < SHM_MAX_SEGMENTS; i++) {
+        if (segments[i] == segment) {
+            segments[i] = NULL;
+            break;
+        }
+    }
+    kmem_cache_free(shm_cache, segment);
+}
+
+// Paylaşılan bellek yönetimini başlat
+int shm_init() {
+    memset(segments, 0, sizeof(segments));
+
+    shm_cache = kmem_cache_create("shm_segment", sizeof(shm_segment_t), 8, NULL);
+    terminal_writestring("Paylasilan bellek yonetimi baslatildi.\n");
+    return SHM_SUCCESS;
+}
+
+// Yeni segment oluştur (ad boş olabilir)
+static int shm_create(const char* name, uint64_t size, shm_segment_t** created) {
+    if (size == 0 || size > SHM_MAX_SIZE) {
+        return SHM_ERROR_INVALID;
+    }
+
+    // Boş bir yuva bul
+    int slot = -1;
+    for (int i = 0; i < SHM_MAX_SEGMENTS; i++) {
+        if (segments[i] == NULL) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot == -1) {
+        return SHM_ERROR_FULL;
+    }
+
+    shm_segment_t* segment = (shm_segment_t*)kmem_cache_alloc(shm_cache);
+    if (!segment) {
+        return SHM_ERROR_NOMEM;
+    }
+
+    segment->size = (size + PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1);
+    segment->page_count = segment->size / PAGE_SIZE;
+
+    // Çerçeveler ilk erişimde tahsis edilir
+    segment->frames = (void**)kmalloc(segment->page_count * sizeof(void*));
+    if (!segment->frames) {
+        kmem_cache_free(shm_cache, segment);
+        return SHM_ERROR_NOMEM;
+    }
+    memset(segment->frames, 0, segment->page_count * sizeof(void*));
+
+    int i;
+    for (i = 0; i < SHM_NAME_MAX - 1 && name[i]; i++) {
+        segment->name[i] = name[i];
+    }
+    segment->name[i] = '\0';
+
+    segment->id = next_shm_id++;
+    segment->attach_count = 0;
+    segment->removed = 0;
+    segments[slot] = segment;
+
+    *created = segment;
+    return SHM_SUCCESS;
+}
+
+// Adlandırılmış segmenti bul ya da oluştur
+int shm_get(const char* name, uint64_t size, uint32_t flags, uint64_t* id) {
+    if (!name[0]) {
+        return SHM_ERROR_INVALID;
+    }
+
+    shm_segment_t* segment = shm_find_by_name(name);
+    if (segment) {
+        if ((flags & SHM_CREAT) && (flags & SHM_EXCL)) {
+            return SHM_ERROR_EXISTS;
+        }
+        if (size > segment->size) {
+            return SHM_ERROR_INVALID;
+        }
+        *id = segment->id;
+        return SHM_SUCCESS;
+    }
+
+    if (!(flags & SHM_CREAT)) {
+        return SHM_ERROR_NOTFOUND;
+    }
+
+    int result = shm_create(name, size, &segment);
+    if (result != SHM_SUCCESS) {
+        return result;
+    }
+
+    *id = segment->id;
+    return SHM_SUCCESS;
+}
+
+// Segmenti verilen adrese bölge olarak bağla; segmentin başı addr'ye denk gelir
+static int shm_attach_segment(process_t* process, shm_segment_t* segment, uint64_t addr, uint32_t vma_flags) {
+    vm_area_t* vma = vma_add(&process->vmas, addr, addr + segment->size, vma_flags, NULL, 0, addr, 0);
+    if (!vma) {
+        return SHM_ERROR_INVALID;
+    }
+
+    vma->shm = segment;
+    shm_ref(segment);
+    return SHM_SUCCESS;
+}
+
+// Segmenti sürecin adres alanına bağla; sayfalar ilk erişimde eşlenir
+int shm_attach(process_t* process, uint64_t id, uint64_t addr, uint32_t flags, uint64_t* attached_addr) {
+    shm_segment_t* segment = shm_find_by_id(id);
+    if (!segment || segment->removed) {
+        return SHM_ERROR_NOTFOUND;
+    }
+
+    // Adres verilmezse paylaşılan bellek bölgesinde boş yer ara
+    if (addr == 0) {
+        addr = vma_find_free(&process->vmas, SHM_BASE, SHM_LIMIT, segment->size);
+        if (addr == 0) {
+            return SHM_ERROR_NOMEM;
+        }
+    } else if ((addr & (PAGE_SIZE - 1)) || addr < USER_BASE || addr + segment->size > USER_STACK_TOP) {
+        return SHM_ERROR_INVALID;
+    }
+
+    uint32_t vma_flags = VMA_READ;
+    if (flags & SHM_RDONLY) {
+        vma_flags |= VMA_RDONLY;
+    } else {
+        vma_flags |= VMA_WRITE;
+    }
+
+    int result = shm_attach_segment(process, segment, addr, vma_flags);
+    if (result != SHM_SUCCESS) {
+        return result;
+    }
+
+    *attached_addr = addr;
+    return SHM_SUCCESS;
+}
+
+// Adsız segment oluşturup bağla (MAP_SHARED | MAP_ANONYMOUS); fork ile paylaşılır
+// ve son bölge kaldırılınca serbest kalır
+int shm_map_anonymous(process_t* process, uint64_t addr, uint64_t size, uint32_t vma_flags) {
+    shm_segment_t* segment;
+    int result = shm_create("", size, &segment);
+    if (result != SHM_SUCCESS) {
+        return result;
+    }
+    segment->removed = 1;
+
+    result = shm_attach_segment(process, segment, addr, vma_flags);
+    if (result != SHM_SUCCESS) {
+        shm_destroy(segment);
+    }
+    return result;
+}
+
+// Bağlanan adresteki segmenti ayır (munmap ile bölünmüş parçalar dahil)
+int shm_detach(process_t* process, uint64_t addr) {
+    vm_area_t* vma = vma_find(&process->vmas, addr);
+    if (!vma || !vma->shm || (vma->flags & VMA_SPECIAL) || vma->file_start != addr) {
+        return SHM_ERROR_INVALID;
+    }
+
+    // Eşlenmiş sayfalar kaldırılır; çerçeveler segmentte kalır
+    shm_segment_t* segment = vma->shm;
+    uint64_t end = addr + segment->size;
+    while (vma && vma->start < end) {
+        vm_area_t* next = vma->next;
+        if (vma->shm == segment && vma->file_start == addr) {
+            vma_unmap(&process->vmas, (void*)process->page_directory, vma->start, vma->end);
+        }
+        vma = next;
+    }
+    return SHM_SUCCESS;
+}
+
+// Segmenti sil; bağlı süreç kalmayınca bellek serbest bırakılır
+int shm_remove(uint64_t id) {
+    shm_segment_t* segment = shm_find_by_id(id);
+    if (!segment || segment->removed) {
+        return SHM_ERROR_NOTFOUND;
+    }
+
+    // Aynı adla yeni segment oluşturulabilsin
+    segment->removed = 1;
+    segment->name[0] = '\0';
+
+    if (segment->attach_count == 0) {
+        shm_destroy(segment);
+    }
+    return SHM_SUCCESS;
+}
+
+// Segmente bağlı bölge sayısını artır
+void shm_ref(shm_segment_t* segment) {
+    segment->attach_count++;
+}
+
+// Bölge segmentten ayrıldı; silinmiş segment son ayrılmada serbest kalır
+void shm_unref(shm_segment_t* segment) {
+    if (segment->attach_count > 0) {
+        segment->attach_count--;
+    }
+
+    if (segment->removed && segment->attach_count == 0) {
+        shm_destroy(segment);
+    }
+}
+
+// Segmentin index'inci sayfasının çerçevesi (gerekirse sıfırlanmış tahsis edilir)
+void* shm_get_frame(shm_segment_t* segment, uint64_t index) {
+    if (index >= segment->page_count) {
+        return NULL;
+    }
+
+    if (!segment->frames[index]) {
+        segment->frames[index] = paging_alloc_page(PAGE_ALLOC_ZERO);
+    }
+    return segment->frames[index];
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef SHM_H
+#define SHM_H
+
+#include <stdint.h>
+#include "process.h"
+
+// Segment sınırları
+#define SHM_MAX_SEGMENTS 32
+#define SHM_NAME_MAX     32
+#define SHM_MAX_SIZE     (16 * 1024 * 1024)  // 16 MB
+
+// Adres verilmeyen bağlamalar için kullanıcı alanında aranan bölge
+#define SHM_BASE  0x0000100000000000
+#define SHM_LIMIT 0x0000200000000000
+
+// shmget bayrakları
+#define SHM_CREAT  0x1   // Yoksa oluştur
+#define SHM_EXCL   0x2   // Varsa hata ver (SHM_CREAT ile)
+
+// shmat bayrakları
+#define SHM_RDONLY 0x1   // Salt okunur bağla
+
+// shmctl komutları
+#define SHM_RMID   0     // Segmenti sil (son ayrılmada serbest kalır)
+
+// Paylaşılan bellek hata kodları
+#define SHM_SUCCESS         0
+#define SHM_ERROR_NOTFOUND -1
+#define SHM_ERROR_EXISTS   -2
+#define SHM_ERROR_FULL     -3
+#define SHM_ERROR_INVALID  -4
+#define SHM_ERROR_NOMEM    -5
+
+// Adlandırılmış paylaşılan bellek segmenti
+// Çerçeveler ilk erişimde tahsis edilir ve tüm bağlayan süreçlere aynen eşlenir
+typedef struct shm_segment {
+    uint64_t id;                  // Benzersiz segment kimliği
+    char name[SHM_NAME_MAX];      // Segment adı (silinince boşaltılır)
+    uint64_t size;                // Boyut (sayfa hizalı)
+    uint64_t page_count;          // Sayfa sayısı
+    void** frames;                // Fiziksel çerçeveler (NULL = henüz tahsis edilmedi)
+    uint32_t attach_count;        // Segmente bağlı bölge sayısı
+    uint8_t removed;              // Silindi, son ayrılmada serbest bırakılacak
+} shm_segment_t;
+
+// Paylaşılan bellek yönetimi
+int shm_init();
+int shm_get(const char* name, uint64_t size, uint32_t flags, uint64_t* id);
+int shm_attach(process_t* process, uint64_t id, uint64_t addr, uint32_t flags, uint64_t* attached_addr);
+int shm_detach(process_t* process, uint64_t addr);
+int shm_map_anonymous(process_t* process, uint64_t addr, uint64_t size, uint32_t vma_flags);
+int shm_remove(uint64_t id);
+
+// Bölge işlevleri için
+void shm_ref(shm_segment_t* segment);
+void shm_unref(shm_segment_t* segment);
+void* shm_get_frame(shm_segment_t* segment, uint64_t index);
+
+#endif // SHM_H
\ No newline at end of file
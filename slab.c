@@ -0,0 +1,242 @@
+#include "kernel.h"
+#include "slab.h"
+#include "paging.h"
+
+// Önbellek tanımlayıcılarının kendisi de bir önbellekten gelir
+static kmem_cache_t cache_cache;
+static uint8_t slab_initialized = 0;
+
+// Global önbellek listesi
+static kmem_cache_t* cache_list = NULL;
+
+// Nesnenin serbest liste bağına eriş
+static inline void** slab_free_link(kmem_cache_t* cache, void* obj) {
+    return (void**)((uint64_t)obj + cache->free_offset);
+}
+
+// Önbellek tanımlayıcısını doldur
+static void kmem_cache_setup(kmem_cache_t* cache, const char* name, size_t size, size_t align, kmem_ctor_t ctor) {
+    memset(cache, 0, sizeof(kmem_cache_t));
+
+    // Adı kopyala
+    int i;
+    for (i = 0; i < 31 && name[i]; i++) {
+        cache->name[i] = name[i];
+    }
+    cache->name[i] = '\0';
+
+    if (align < sizeof(void*)) {
+        align = sizeof(void*);
+    }
+    if (align > PAGE_SIZE) {
+        align = PAGE_SIZE;
+    }
+    cache->align = align;
+
+    cache->object_size = size;
+    cache->ctor = ctor;
+
+    // Yapıcı varsa nesnenin kurulmuş durumu bozulmasın diye
+    // serbest bağ nesnenin arkasına konur
+    size_t stride = size;
+    if (ctor) {
+        stride = (stride + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+        cache->free_offset = stride;
+        stride += sizeof(void*);
+    } else {
+        if (stride < sizeof(void*)) {
+            stride = sizeof(void*);
+        }
+        cache->free_offset = 0;
+    }
+    cache->stride = (stride + align - 1) & ~(align - 1);
+
+    // Slab boyutu: küçük nesneler tek sayfa, büyükler en az SLAB_MIN_OBJECTS nesne
+    size_t header = (sizeof(kmem_slab_t) + align - 1) & ~(align - 1);
+    if (header + cache->stride * SLAB_MIN_OBJECTS <= PAGE_SIZE) {
+        cache->pages_per_slab = 1;
+    } else {
+        cache->pages_per_slab = (header + cache->stride * SLAB_MIN_OBJECTS + PAGE_SIZE - 1) / PAGE_SIZE;
+    }
+    cache->objects_per_slab = (cache->pages_per_slab * PAGE_SIZE - header) / cache->stride;
+
+    // Global listeye ekle
+    cache->next = cache_list;
+    cache_list = cache;
+}
+
+// Düşük bellek bildirimi: tüm önbelleklerin boş slab'larını geri ver
+// Boş slab'lar her iki seviyede de ucuzca geri verilir, seviye ayrımı gerekmez
+static uint64_t slab_pressure(uint32_t level) {
+    (void)level;
+    return kmem_cache_shrink_all();
+}
+
+// İlk çağrıda önbellek tanımlayıcıları için önbelleği kur
+static void slab_init() {
+    if (slab_initialized) return;
+    kmem_cache_setup(&cache_cache, "kmem_cache", sizeof(kmem_cache_t), 0, NULL);
+    paging_register_pressure_callback(slab_pressure);
+    slab_initialized = 1;
+}
+
+// Önbelleğe yeni bir slab ekle ve nesnelerini serbest listeye diz
+static int kmem_cache_grow(kmem_cache_t* cache) {
+    kmem_slab_t* slab = (kmem_slab_t*)kmalloc_pages(cache->pages_per_slab);
+    if (!slab) {
+        return 0;
+    }
+
+    slab->page_count = cache->pages_per_slab;
+    slab->next = cache->slabs;
+    cache->slabs = slab;
+
+    // Nesneler başlıktan sonra hizalı başlar
+    uint64_t first = ((uint64_t)slab + sizeof(kmem_slab_t) + cache->align - 1) & ~(cache->align - 1);
+
+    // Ters sırada ekle ki ilk nesne listenin başında olsun
+    for (uint64_t i = cache->objects_per_slab; i > 0; i--) {
+        void* obj = (void*)(first + (i - 1) * cache->stride);
+        if (cache->ctor) {
+            cache->ctor(obj);
+        }
+        *slab_free_link(cache, obj) = cache->free_list;
+        cache->free_list = obj;
+    }
+
+    cache->slab_count++;
+    cache->total_objects += cache->objects_per_slab;
+    return 1;
+}
+
+// Yeni nesne önbelleği oluştur
+kmem_cache_t* kmem_cache_create(const char* name, size_t size, size_t align, kmem_ctor_t ctor) {
+    slab_init();
+
+    if (size == 0) {
+        return NULL;
+    }
+
+    kmem_cache_t* cache = (kmem_cache_t*)kmem_cache_alloc(&cache_cache);
+    if (!cache) {
+        return NULL;
+    }
+
+    kmem_cache_setup(cache, name, size, align, ctor);
+    return cache;
+}
+
+// Önbellekten nesne al
+void* kmem_cache_alloc(kmem_cache_t* cache) {
+    if (!cache->free_list && !kmem_cache_grow(cache)) {
+        return NULL;
+    }
+
+    void* obj = cache->free_list;
+    cache->free_list = *slab_free_link(cache, obj);
+
+    cache->active_objects++;
+    cache->alloc_count++;
+    return obj;
+}
+
+// Nesneyi önbelleğe geri ver
+void kmem_cache_free(kmem_cache_t* cache, void* obj) {
+    if (obj == NULL) {
+        return;
+    }
+
+    *slab_free_link(cache, obj) = cache->free_list;
+    cache->free_list = obj;
+
+    cache->active_objects--;
+    cache->free_count++;
+}
+
+// Önbelleği ve tüm slab'larını serbest bırak
+void kmem_cache_destroy(kmem_cache_t* cache) {
+    if (cache->active_objects != 0) {
+        terminal_writestring("Hata: Kullanimda nesnesi olan onbellek yok edilemez: ");
+        terminal_writestring(cache->name);
+        terminal_writestring("\n");
+        return;
+    }
+
+    // Slab sayfalarını geri ver
+    kmem_slab_t* slab = cache->slabs;
+    while (slab) {
+        kmem_slab_t* next = slab->next;
+        kfree_pages(slab, slab->page_count);
+        slab = next;
+    }
+
+    // Global listeden çıkar
+    kmem_cache_t** link = &cache_list;
+    while (*link && *link != cache) {
+        link = &(*link)->next;
+    }
+    if (*link) {
+        *link = cache->next;
+    }
+
+    kmem_cache_free(&cache_cache, cache);
+}
+
+// Tüm nesneleri boş slab'ları sisteme geri ver; geri verilen sayfa sayısını döndürür
+uint64_t kmem_cache_shrink(kmem_cache_t* cache) {
+    uint64_t released = 0;
+
+    kmem_slab_t** link = &cache->slabs;
+    while (*link && cache->active_objects < cache->total_objects) {
+        kmem_slab_t* slab = *link;
+        uint64_t start = (uint64_t)slab;
+        uint64_t end = start + slab->page_count * PAGE_SIZE;
+
+        // Serbest listede bu slab'a ait nesneleri say
+        uint64_t free_objects = 0;
+        for (void* obj = cache->free_list; obj; obj = *slab_free_link(cache, obj)) {
+            if ((uint64_t)obj >= start && (uint64_t)obj < end) {
+                free_objects++;
+            }
+        }
+
+        if (free_objects < cache->objects_per_slab) {
+            link = &slab->next;
+            continue;
+        }
+
+        // Nesnelerini serbest listeden çıkar
+        void** obj_link = &cache->free_list;
+        while (*obj_link) {
+            void* obj = *obj_link;
+            if ((uint64_t)obj >= start && (uint64_t)obj < end) {
+                *obj_link = *slab_free_link(cache, obj);
+            } else {
+                obj_link = slab_free_link(cache, obj);
+            }
+        }
+
+        *link = slab->next;
+        cache->slab_count--;
+        cache->total_objects -= cache->objects_per_slab;
+        released += slab->page_count;
+        kfree_pages(slab, slab->page_count);
+    }
+
+    return released;
+}
+
+// Tüm önbellekleri küçült
+uint64_t kmem_cache_shrink_all() {
+    uint64_t released = 0;
+    for (kmem_cache_t* cache = cache_list; cache; cache = cache->next) {
+        released += kmem_cache_shrink(cache);
+    }
+    return released;
+}
+
+// Global önbellek listesinin başı
+kmem_cache_t* kmem_cache_first() {
+    slab_init();
+    return cache_list;
+}
\ No newline at end of file
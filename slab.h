@@ -0,0 +1,54 @@
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Slab başına hedeflenen en az nesne sayısı
+#define SLAB_MIN_OBJECTS 8
+
+// Nesne yapıcı fonksiyon türü
+typedef void (*kmem_ctor_t)(void* obj);
+
+// Slab: kmalloc_pages ile alınmış, sabit boyutlu nesnelere bölünmüş sayfa grubu
+typedef struct kmem_slab {
+    struct kmem_slab* next;      // Önbellekteki sonraki slab
+    uint64_t page_count;         // Slab'ın sayfa sayısı
+} kmem_slab_t;
+
+// Nesne önbelleği
+typedef struct kmem_cache {
+    char name[32];               // Önbellek adı
+    size_t object_size;          // İstenen nesne boyutu
+    size_t stride;               // Hizalanmış nesne aralığı (serbest bağ dahil)
+    size_t free_offset;          // Serbest liste bağının nesne içindeki konumu
+    size_t align;                // Nesne hizalaması
+    uint64_t pages_per_slab;     // Slab başına sayfa sayısı
+    uint64_t objects_per_slab;   // Slab başına nesne sayısı
+    kmem_ctor_t ctor;            // Yapıcı (isteğe bağlı)
+
+    void* free_list;             // Serbest nesne listesi
+    kmem_slab_t* slabs;          // Önbelleğe ait slab'lar
+
+    // Kullanım sayaçları
+    uint64_t slab_count;         // Slab sayısı
+    uint64_t total_objects;      // Toplam nesne sayısı
+    uint64_t active_objects;     // Kullanımdaki nesne sayısı
+    uint64_t alloc_count;        // Toplam tahsis sayısı
+    uint64_t free_count;         // Toplam serbest bırakma sayısı
+
+    struct kmem_cache* next;     // Global önbellek listesi
+} kmem_cache_t;
+
+// Önbellek işlevleri
+kmem_cache_t* kmem_cache_create(const char* name, size_t size, size_t align, kmem_ctor_t ctor);
+void* kmem_cache_alloc(kmem_cache_t* cache);
+void kmem_cache_free(kmem_cache_t* cache, void* obj);
+void kmem_cache_destroy(kmem_cache_t* cache);
+uint64_t kmem_cache_shrink(kmem_cache_t* cache);
+uint64_t kmem_cache_shrink_all();
+
+// Tüm önbellekleri gezmek için liste başı
+kmem_cache_t* kmem_cache_first();
+
+#endif // SLAB_H
\ No newline at end of file
@@ -0,0 +1,228 @@
+#include "kernel.h"
+#include "swap.h"
+#include "paging.h"
+#include "zram.h"
+
+// ATA sürücüsü (filesystem.c ile aynı arabirim)
+extern int ata_read_sectors(uint32_t lba, uint8_t sector_count, void* buffer);
+extern int ata_write_sectors(uint32_t lba, uint8_t sector_count, const void* buffer);
+
+// Takas bölümü
+static uint32_t swap_start_lba = 0;
+static uint64_t swap_slots = 0;
+static uint16_t* swap_map = NULL;        // Yuva başına referans sayısı (0 = boş)
+static uint64_t swap_next = 0;           // Sonraki küme aramasının başladığı yuva
+static int swap_failed = 0;              // Yazma hatası sonrası yeni sayfa yazılmaz
+
+// Bekleyen küme: [cluster_base, cluster_base + cluster_count) yuvaları tamponda
+static uint8_t* cluster_buf = NULL;
+static uint64_t cluster_base = 0;
+static uint32_t cluster_count = 0;
+static uint32_t cluster_reserved = 0;    // Kümeye ayrılan ardışık boş yuva sayısı
+
+static swap_info_t swap_stats;
+
+// Yuvanın disk adresi
+static uint32_t swap_slot_lba(uint64_t slot) {
+    return swap_start_lba + (uint32_t)((SWAP_HEADER_PAGES + slot) * SWAP_SECTORS_PER_PAGE);
+}
+
+// Yeni küme için ardışık boş yuvalar ayır (en fazla SWAP_CLUSTER_PAGES)
+// Arama son kümenin ardından sürer ki yazmalar diskte sıralı ilerlesin
+static int swap_reserve_cluster() {
+    for (uint64_t i = 0; i < swap_slots; i++) {
+        uint64_t slot = (swap_next + i) % swap_slots;
+        if (swap_map[slot]) {
+            continue;
+        }
+
+        uint32_t run = 1;
+        while (run < SWAP_CLUSTER_PAGES && slot + run < swap_slots && !swap_map[slot + run]) {
+            run++;
+        }
+        cluster_base = slot;
+        cluster_reserved = run;
+        return 1;
+    }
+    return 0;
+}
+
+// Takas bölümünü bul ve yuva tablosunu hazırla
+int swap_init() {
+    memset(&swap_stats, 0, sizeof(swap_stats));
+
+    uint8_t mbr[SWAP_SECTOR_SIZE];
+    if (ata_read_sectors(0, 1, mbr) != 0 || mbr[510] != 0x55 || mbr[511] != 0xAA) {
+        terminal_writestring("Disk takas alani yok: bolum tablosu okunamadi.\n");
+        return 0;
+    }
+
+    // İlk takas bölümü kullanılır
+    uint32_t sectors = 0;
+    for (int i = 0; i < 4; i++) {
+        uint8_t* entry = mbr + 0x1BE + i * 16;
+        if (entry[4] == SWAP_PARTITION_TYPE) {
+            swap_start_lba = *(uint32_t*)(entry + 8);
+            sectors = *(uint32_t*)(entry + 12);
+            break;
+        }
+    }
+
+    uint64_t slots = sectors / SWAP_SECTORS_PER_PAGE;
+    if (slots <= SWAP_HEADER_PAGES) {
+        terminal_writestring("Disk takas alani yok: takas bolumu bulunamadi.\n");
+        return 0;
+    }
+    slots -= SWAP_HEADER_PAGES;
+    if (slots > SWAP_MAX_SLOTS) {
+        slots = SWAP_MAX_SLOTS;
+    }
+
+    uint64_t map_pages = (slots * sizeof(uint16_t) + PAGE_SIZE - 1) / PAGE_SIZE;
+    swap_map = (uint16_t*)kmalloc_pages(map_pages);
+    cluster_buf = (uint8_t*)kmalloc_pages(SWAP_CLUSTER_PAGES);
+    if (!swap_map || !cluster_buf) {
+        if (swap_map) {
+            kfree_pages(swap_map, map_pages);
+            swap_map = NULL;
+        }
+        terminal_writestring("Hata: Takas tablolari ayrilamadi!\n");
+        return 0;
+    }
+
+    swap_slots = slots;
+    swap_stats.total_slots = slots;
+
+    terminal_writestring("Takas alani etkin: ");
+    char size_str[20];
+    int_to_string(slots * PAGE_SIZE / 1024, size_str);
+    terminal_writestring(size_str);
+    terminal_writestring(" KB\n");
+    return 1;
+}
+
+// Sayfa disk takas alanına yazılabilir mi?
+static int swap_disk_enabled() {
+    return swap_map && !swap_failed;
+}
+
+// Sayfa herhangi bir takas katmanına yazılabilir mi?
+int swap_enabled() {
+    return zram_enabled() || swap_disk_enabled();
+}
+
+// İstatistikleri al
+void swap_get_info(swap_info_t* info) {
+    *info = swap_stats;
+}
+
+// Sayfayı önce sıkıştırılmış belleğe, sığmazsa bekleyen disk kümesine yaz ve yuvasını ayır
+// Küme doluysa 0 döner; çağıran önce swap_flush ile kümeyi yazmalıdır
+int swap_out_page(void* phys_addr, uint64_t* slot) {
+    uint64_t index;
+    if (zram_store(phys_addr, &index)) {
+        *slot = SWAP_ZRAM_SLOT | index;
+        return 1;
+    }
+
+    if (!swap_disk_enabled()) {
+        return 0;
+    }
+
+    if (cluster_count == cluster_reserved) {
+        if (cluster_count || !swap_reserve_cluster()) {
+            return 0;
+        }
+    }
+
+    memcpy(cluster_buf + cluster_count * PAGE_SIZE, phys_to_virt((uint64_t)phys_addr), PAGE_SIZE);
+    *slot = cluster_base + cluster_count;
+    swap_map[*slot] = 1;
+    cluster_count++;
+
+    swap_stats.used_slots++;
+    swap_stats.pages_out++;
+    return 1;
+}
+
+// Bekleyen küme yeni sayfa alamıyor mu?
+int swap_cluster_full() {
+    return cluster_count && cluster_count == cluster_reserved;
+}
+
+// Bekleyen kümeyi tek sıralı yazma ile diske yaz
+// Yazma başarısızsa küme bellekte kalır (okumalar tampondan karşılanır) ve takas durur
+void swap_flush() {
+    if (!cluster_count || swap_failed) {
+        return;
+    }
+
+    uint32_t count = cluster_count;
+    if (ata_write_sectors(swap_slot_lba(cluster_base), count * SWAP_SECTORS_PER_PAGE, cluster_buf) != 0) {
+        swap_stats.io_errors++;
+        swap_failed = 1;
+        terminal_writestring("Hata: Takas alanina yazilamadi, takas durduruldu!\n");
+        return;
+    }
+
+    uint64_t rflags = irq_save();
+    swap_next = cluster_base + count;
+    cluster_count = 0;
+    cluster_reserved = 0;
+    swap_stats.clusters_written++;
+    irq_restore(rflags);
+}
+
+// Yuvadaki sayfayı çerçeveye oku; henüz yazılmamışsa bekleyen kümeden kopyalanır
+int swap_read_page(uint64_t slot, void* phys_addr) {
+    if (slot & SWAP_ZRAM_SLOT) {
+        return zram_load(slot & ~SWAP_ZRAM_SLOT, phys_addr);
+    }
+
+    void* dest = phys_to_virt((uint64_t)phys_addr);
+
+    uint64_t rflags = irq_save();
+    if (slot >= cluster_base && slot < cluster_base + cluster_count) {
+        memcpy(dest, cluster_buf + (slot - cluster_base) * PAGE_SIZE, PAGE_SIZE);
+        swap_stats.cluster_hits++;
+        swap_stats.pages_in++;
+        irq_restore(rflags);
+        return 1;
+    }
+    irq_restore(rflags);
+
+    if (ata_read_sectors(swap_slot_lba(slot), SWAP_SECTORS_PER_PAGE, dest) != 0) {
+        swap_stats.io_errors++;
+        return 0;
+    }
+    swap_stats.pages_in++;
+    return 1;
+}
+
+// Yuvaya bir sahip daha ekle (adres alanı çoğaltma)
+void swap_dup(uint64_t slot) {
+    if (slot & SWAP_ZRAM_SLOT) {
+        zram_dup(slot & ~SWAP_ZRAM_SLOT);
+    } else if (slot < swap_slots) {
+        uint64_t rflags = irq_save();
+        swap_map[slot]++;
+        irq_restore(rflags);
+    }
+}
+
+// Yuvanın bir sahibini bırak; son sahip bırakınca yuva boşalır
+void swap_free(uint64_t slot) {
+    if (slot & SWAP_ZRAM_SLOT) {
+        zram_free(slot & ~SWAP_ZRAM_SLOT);
+        return;
+    }
+    if (slot >= swap_slots) {
+        return;
+    }
+
+    uint64_t rflags = irq_save();
+    if (swap_map[slot] && --swap_map[slot] == 0) {
+        swap_stats.used_slots--;
+    }
+    irq_restore(rflags);
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef SWAP_H
+#define SWAP_H
+
+#include <stdint.h>
+
+// MBR bölüm türü (Linux takas alanı)
+#define SWAP_PARTITION_TYPE  0x82
+
+// Disk düzeni: ilk sayfa takas imzası için ayrılır, ardından sayfa başına bir yuva
+#define SWAP_SECTOR_SIZE      512
+#define SWAP_SECTORS_PER_PAGE 8
+#define SWAP_HEADER_PAGES     1
+
+// Yuva tablosu üst sınırı (65536 yuva = 256 MB takas alanı)
+#define SWAP_MAX_SLOTS        65536
+
+// Dışarı yazılan sayfalar ardışık yuvalarda biriktirilip tek G/Ç ile yazılır
+// (16 sayfa = 128 sektör, ATA sektör sayısı 8 bittir)
+#define SWAP_CLUSTER_PAGES    16
+
+// Bu bitle işaretli yuva sıkıştırılmış bellek katmanındadır (zram.c), diske gitmez
+#define SWAP_ZRAM_SLOT        0x80000000ULL
+
+// Takas alanı istatistikleri
+typedef struct {
+    uint64_t total_slots;        // Toplam yuva (0 = takas alanı yok)
+    uint64_t used_slots;         // Kullanımdaki yuva
+    uint64_t pages_out;          // Diske yazılan sayfa
+    uint64_t pages_in;           // Diskten okunan sayfa
+    uint64_t clusters_written;   // Yazılan küme (G/Ç isteği)
+    uint64_t cluster_hits;       // Henüz yazılmamış kümeden karşılanan okuma
+    uint64_t io_errors;          // Başarısız disk işlemi
+} swap_info_t;
+
+// Takas alanı işlevleri (sıkıştırılmış bellek ilk katman, disk bölümü ikinci)
+int swap_init();
+int swap_enabled();
+void swap_get_info(swap_info_t* info);
+
+// Sayfayı sıkıştırılmış belleğe ya da bekleyen kümeye ekle, yuvasını döndür
+// (1 = başarılı; kesmeler kapalı çağrılır)
+int swap_out_page(void* phys_addr, uint64_t* slot);
+int swap_cluster_full();
+void swap_flush();
+
+// Yuvadaki sayfayı çerçeveye oku (1 = başarılı)
+int swap_read_page(uint64_t slot, void* phys_addr);
+
+// Yuva referansları (çoğaltılan adres alanları yuvayı paylaşır)
+void swap_dup(uint64_t slot);
+void swap_free(uint64_t slot);
+
+#endif // SWAP_H
\ No newline at end of file
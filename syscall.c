@@ -7,6 +7,10 @@
 #include "timer.h"
 #include "usermode.h"
 #include "signals.h"
+#include "paging.h"
+#include "vma.h"
+#include "shm.h"
+#include "vdso.h"
 
 // Sistem çağrı tablosu
 static void* syscall_table[64] = {
@@ -36,7 +40,15 @@ static void* syscall_table[64] = {
     (void*)sys_setpgid,
     (void*)sys_getpgid,
     (void*)sys_setsid,
-    (void*)sys_getsid
+    (void*)sys_getsid,
+    (void*)sys_shmget,
+    (void*)sys_shmat,
+    (void*)sys_shmdt,
+    (void*)sys_shmctl,
+    (void*)sys_brk,
+    (void*)sys_mmap,
+    (void*)sys_munmap,
+    (void*)sys_mprotect
 };
 
 // Sistem çağrı işleyici fonksiyonları tablosu
@@ -84,6 +96,9 @@ void init_syscalls() {
     // Sinyal sistemini başlat
     signal_init();
     
+    // Paylaşılan bellek sistemini başlat
+    shm_init();
+    
     terminal_writestring("Sistem cagrilari baslatildi.\n");
 }
 
@@ -108,14 +123,42 @@ uint64_t sys_fork() {
         return -1;
     }
     
+    // Kullanıcı adres alanını yazınca kopyala olarak çoğalt (yalnız tablolar kopyalanır)
+    void* child_pml4 = NULL;
+    vm_map_t child_vmas;
+    vma_map_init(&child_vmas);
+    if (current->page_directory) {
+        child_pml4 = paging_clone_user_address_space((void*)current->page_directory);
+        if (!child_pml4) {
+            return -1;
+        }
+        
+        if (!vma_clone(&current->vmas, &child_vmas)) {
+            paging_free_user_address_space(child_pml4);
+            return -1;
+        }
+    }
+    
     // Yeni süreç oluştur
     uint64_t child_pid = create_process(current->name, 0, current->pid);
-    if (child_pid == 0) {
+    process_t* child = child_pid ? get_process(child_pid) : NULL;
+    if (!child) {
+        vma_free_all(&child_vmas);
+        if (child_pml4) {
+            paging_free_user_address_space(child_pml4);
+        }
         return -1;
     }
     
-    process_t* child = get_process(child_pid);
-    if (!child) {
+    child->page_directory = (uint64_t)child_pml4;
+    child->vmas = child_vmas;
+    child->brk_start = current->brk_start;
+    child->brk = current->brk;
+    
+    // vDSO kimlik sayfası çocuğa özel olmalı; paylaşılırsa çocuk ebeveynin kimliğini görür
+    if (!vdso_fork(child)) {
+        terminal_writestring("Hata: Cocuk surecin vDSO sayfasi ayrilamadi!\n");
+        release_process(child_pid);
         return -1;
     }
     
@@ -677,4 +720,188 @@ uint64_t sys_getsid(uint64_t pid) {
     }
     
     return process->session_id;
-} 
\ No newline at end of file
+} 
+
+// Paylaşılan bellek segmenti bul ya da oluştur
+uint64_t sys_shmget(const char* name, uint64_t size, uint64_t flags) {
+    // Adı kullanıcı belleğinden kopyala
+    char kname[SHM_NAME_MAX];
+    int len = 0;
+    while (1) {
+        if (len == SHM_NAME_MAX || !usermode_copy_from_user(&kname[len], name + len, 1)) {
+            return -1;
+        }
+        if (kname[len] == '\0') {
+            break;
+        }
+        len++;
+    }
+    
+    uint64_t id;
+    if (shm_get(kname, size, flags, &id) != SHM_SUCCESS) {
+        return -1;
+    }
+    return id;
+}
+
+// Segmenti geçerli sürecin adres alanına bağla
+uint64_t sys_shmat(uint64_t id, uint64_t addr, uint64_t flags) {
+    process_t* current = get_current_process();
+    if (!current || !current->page_directory) {
+        return -1;
+    }
+    
+    uint64_t attached_addr;
+    if (shm_attach(current, id, addr, flags, &attached_addr) != SHM_SUCCESS) {
+        return -1;
+    }
+    return attached_addr;
+}
+
+// Segmenti ayır
+uint64_t sys_shmdt(uint64_t addr) {
+    process_t* current = get_current_process();
+    if (!current) {
+        return -1;
+    }
+    
+    return shm_detach(current, addr) == SHM_SUCCESS ? 0 : -1;
+}
+
+// Segment denetimi
+uint64_t sys_shmctl(uint64_t id, uint64_t cmd) {
+    if (cmd != SHM_RMID) {
+        return -1;
+    }
+    
+    return shm_remove(id) == SHM_SUCCESS ? 0 : -1;
+}
+
+// PROT_* bitlerini bölge bayraklarına çevir
+static uint32_t syscall_prot_to_vma(uint64_t prot) {
+    uint32_t flags = 0;
+    if (prot & PROT_READ) {
+        flags |= VMA_READ;
+    }
+    if (prot & PROT_WRITE) {
+        flags |= VMA_READ | VMA_WRITE;
+    }
+    if (prot & PROT_EXEC) {
+        flags |= VMA_EXEC;
+    }
+    return flags;
+}
+
+// Program sonunu ayarla; 0 ya da geçersiz adreste geçerli değer döner
+uint64_t sys_brk(uint64_t addr) {
+    process_t* current = get_current_process();
+    if (!current || !current->page_directory) {
+        return 0;
+    }
+    
+    if (addr < current->brk_start || addr >= VMA_MMAP_BASE) {
+        return current->brk;
+    }
+    
+    uint64_t old_end = (current->brk + PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1);
+    uint64_t new_end = (addr + PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1);
+    
+    if (new_end > old_end) {
+        // Büyütme: yeni sayfalar ilk erişimde sıfırla doldurulur
+        if (!vma_add_anon(&current->vmas, old_end, new_end, VMA_READ | VMA_WRITE)) {
+            return current->brk;
+        }
+    } else if (new_end < old_end) {
+        // Küçültme: sayfalar çekirdeğe geri verilir
+        if (!vma_unmap(&current->vmas, (void*)current->page_directory, new_end, old_end)) {
+            return current->brk;
+        }
+    }
+    
+    current->brk = addr;
+    return addr;
+}
+
+// Bellek eşle; başarıda eşlenen adres, hatada -1 döner
+// Dosya tanımlayıcısı tablosu henüz fs_file_t kayıtlarını tutmadığından yalnız
+// MAP_ANONYMOUS eşlemeleri desteklenir
+uint64_t sys_mmap(uint64_t addr, uint64_t length, uint64_t prot, uint64_t flags, uint64_t fd, uint64_t offset) {
+    process_t* current = get_current_process();
+    if (!current || !current->page_directory || length == 0) {
+        return -1;
+    }
+    
+    // Tam olarak biri seçilmeli
+    if (!(flags & MAP_SHARED) == !(flags & MAP_PRIVATE)) {
+        return -1;
+    }
+    
+    uint64_t size = (length + PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1);
+    if (size < length || (offset & (PAGE_SIZE - 1))) {
+        return -1;
+    }
+    
+    // file_descriptors yuvaları düz tamsayıdır (ör. 1 = stdout), dosya nesnesine çevrilemez
+    (void)fd;
+    if (!(flags & MAP_ANONYMOUS)) {
+        return -1;
+    }
+    
+    void* user_pml4 = (void*)current->page_directory;
+    if (flags & MAP_FIXED) {
+        if ((addr & (PAGE_SIZE - 1)) || addr < USER_BASE || addr + size > USER_STACK_TOP || addr + size < addr) {
+            return -1;
+        }
+        
+        // Aralıktaki eski eşlemeler kaldırılır
+        if (!vma_unmap(&current->vmas, user_pml4, addr, addr + size)) {
+            return -1;
+        }
+    } else {
+        // Adres ipucu boşsa kullanılır, değilse eşleme bölgesinde yer aranır
+        addr &= ~(uint64_t)(PAGE_SIZE - 1);
+        if (addr < USER_BASE || addr + size > USER_STACK_TOP ||
+            vma_find_free(&current->vmas, addr, addr + size, size) != addr) {
+            addr = vma_find_free(&current->vmas, VMA_MMAP_BASE, VMA_MMAP_LIMIT, size);
+            if (addr == 0) {
+                return -1;
+            }
+        }
+    }
+    
+    uint32_t vma_flags = syscall_prot_to_vma(prot);
+    if (flags & MAP_SHARED) {
+        return shm_map_anonymous(current, addr, size, vma_flags) == SHM_SUCCESS ? addr : (uint64_t)-1;
+    }
+    
+    return vma_add_anon(&current->vmas, addr, addr + size, vma_flags) ? addr : (uint64_t)-1;
+}
+
+// Bellek eşlemesini kaldır
+uint64_t sys_munmap(uint64_t addr, uint64_t length) {
+    process_t* current = get_current_process();
+    if (!current || !current->page_directory || (addr & (PAGE_SIZE - 1)) || length == 0) {
+        return -1;
+    }
+    
+    if (addr + length > USER_STACK_TOP || addr + length < addr) {
+        return -1;
+    }
+    
+    return vma_unmap(&current->vmas, (void*)current->page_directory, addr, addr + length) ? 0 : -1;
+}
+
+// Bellek izinlerini değiştir
+uint64_t sys_mprotect(uint64_t addr, uint64_t length, uint64_t prot) {
+    process_t* current = get_current_process();
+    if (!current || !current->page_directory || (addr & (PAGE_SIZE - 1)) || length == 0) {
+        return -1;
+    }
+    
+    if (addr + length > USER_STACK_TOP || addr + length < addr) {
+        return -1;
+    }
+    
+    return vma_protect(&current->vmas, (void*)current->page_directory, addr, addr + length,
+                       syscall_prot_to_vma(prot)) ? 0 : -1;
+}
\ No newline at end of file
@@ -31,6 +31,26 @@
 #define SYS_GETPGID    24  // Süreç grubunu al
 #define SYS_SETSID     25  // Yeni oturum oluştur
 #define SYS_GETSID     26  // Oturum kimliğini al
+#define SYS_SHMGET     27  // Paylaşılan bellek segmenti bul/oluştur
+#define SYS_SHMAT      28  // Segmenti adres alanına bağla
+#define SYS_SHMDT      29  // Segmenti ayır
+#define SYS_SHMCTL     30  // Segment denetimi (silme)
+#define SYS_BRK        31  // Program sonunu (heap) ayarla
+#define SYS_MMAP       32  // Bellek eşle
+#define SYS_MUNMAP     33  // Bellek eşlemesini kaldır
+#define SYS_MPROTECT   34  // Bellek izinlerini değiştir
+
+// mmap/mprotect erişim bitleri
+#define PROT_NONE      0x0
+#define PROT_READ      0x1
+#define PROT_WRITE     0x2
+#define PROT_EXEC      0x4
+
+// mmap bayrakları
+#define MAP_SHARED     0x01  // Süreçler (fork) arasında paylaşılır
+#define MAP_PRIVATE    0x02  // Özel kopya
+#define MAP_FIXED      0x10  // Adres aynen kullanılır, eski eşleme kaldırılır
+#define MAP_ANONYMOUS  0x20  // Dosyasız, sıfırla doldurulur
 
 // Sistem çağrı işleyici
 void syscall_handler(registers_t* regs);
@@ -65,5 +85,13 @@ uint64_t sys_setpgid(uint64_t pid, uint64_t pgid);
 uint64_t sys_getpgid(uint64_t pid);
 uint64_t sys_setsid();
 uint64_t sys_getsid(uint64_t pid);
+uint64_t sys_shmget(const char* name, uint64_t size, uint64_t flags);
+uint64_t sys_shmat(uint64_t id, uint64_t addr, uint64_t flags);
+uint64_t sys_shmdt(uint64_t addr);
+uint64_t sys_shmctl(uint64_t id, uint64_t cmd);
+uint64_t sys_brk(uint64_t addr);
+uint64_t sys_mmap(uint64_t addr, uint64_t length, uint64_t prot, uint64_t flags, uint64_t fd, uint64_t offset);
+uint64_t sys_munmap(uint64_t addr, uint64_t length);
+uint64_t sys_mprotect(uint64_t addr, uint64_t length, uint64_t prot);
 
 #endif // SYSCALL_H 
\ No newline at end of file
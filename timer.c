@@ -2,6 +2,7 @@
 #include "timer.h"
 #include "idt.h"
 #include "process.h"
+#include "vdso.h"
 
 // Zamanlayıcı değişkenleri
 static uint64_t timer_ticks = 0;
@@ -44,6 +45,9 @@ void timer_handler(uint64_t int_no) {
     // Tik sayısını artır
     timer_ticks++;
     
+    // Kullanıcı alanının okuduğu zaman sayfasını güncelle
+    vdso_timer_tick(timer_ticks);
+    
     // Kayıtlı bir geri çağırma varsa çağır
     if (timer_callback != NULL) {
         timer_callback(timer_ticks);
@@ -78,6 +82,11 @@ uint64_t timer_get_ticks() {
     return timer_ticks;
 }
 
+// Kesme frekansını al (Hz)
+uint32_t timer_get_frequency() {
+    return timer_frequency;
+}
+
 // Belirtilen milisaniye kadar bekle
 void timer_sleep(uint32_t ms) {
     // Tik cinsinden bekleme süresini hesapla
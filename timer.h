@@ -38,7 +38,9 @@
 void timer_init(uint32_t frequency);
 void timer_handler(uint64_t int_no);
 uint64_t timer_get_ticks();
+uint32_t timer_get_frequency();
 void timer_sleep(uint32_t ms);
+void process_sleep(uint32_t ms);
 
 // Zamanlayıcı geri çağırma
 typedef void (*timer_callback_t)(uint64_t tick);
@@ -2,6 +2,9 @@
 #include "usermode.h"
 #include "paging.h"
 #include "process.h"
+#include "filesystem.h"
+#include "vma.h"
+#include "vdso.h"
 
 // GDT ve TSS yapıları
 static gdt_entry_t gdt[6];  // Null, Kernel Code, Kernel Data, User Code, User Data, TSS
@@ -137,8 +140,23 @@ int usermode_validate_pointer(void* ptr, size_t size, uint32_t access_flags) {
     uint64_t start_page = start_addr & ~0xFFF;
     uint64_t end_page = end_addr & ~0xFFF;
     
+    // Kullanıcı adres alanı olan süreçte sayfalar ilk erişimde tahsis edilir;
+    // henüz eşlenmemiş sayfalar için bölge izinleri esas alınır
+    process_t* current = get_current_process();
+    
     // Her sayfayı kontrol et
     for (uint64_t page = start_page; page <= end_page; page += PAGE_SIZE) {
+        if (current && current->page_directory) {
+            vm_area_t* vma = vma_find(&current->vmas, page);
+            if (!vma || !(vma->flags & (VMA_READ | VMA_EXEC))) {
+                return 0; // Bölge dışında ya da erişime kapalı
+            }
+            if ((access_flags & PAGE_WRITABLE) && !(vma->flags & VMA_WRITE)) {
+                return 0; // Yazma erişimi yok
+            }
+            continue;
+        }
+        
         // Sayfanın fiziksel karşılığını kontrol et
         void* phys_addr = paging_get_physical_address((void*)page);
         if (!phys_addr) {
@@ -201,42 +219,61 @@ int usermode_copy_to_user(void* dst, const void* src, size_t size) {
     return 1; // Başarılı
 }
 
+// İşlemin bölgelerini ve adres alanını bırak (yükleme hatası veya yeniden yükleme)
+static void usermode_release_address_space(process_t* process) {
+    vma_free_all(&process->vmas);
+    if (process->page_directory) {
+        paging_free_user_address_space((void*)process->page_directory);
+        process->page_directory = 0;
+    }
+}
+
 // Kullanıcı programını bellekte oluştur ve yükle
 // Bu basit bir ELF yükleyici olacak 
 int usermode_load_program(process_t* process, const char* filename) {
     // Dosya sisteminden programı oku
-    fs_file_t file;
-    if (fs_open(filename, &file) != FS_SUCCESS) {
+    fs_file_t* file = fs_file_alloc();
+    if (!file) {
+        terminal_writestring("Hata: Dosya yapisi ayrilamadi!\n");
+        return 0;
+    }
+    
+    if (fs_open(filename, file) != FS_SUCCESS) {
         terminal_writestring("Hata: Program dosyasi acilamadi!\n");
+        fs_file_free(file);
         return 0;
     }
     
     // Basit ELF başlık kontrolü (sadece kavramsal örnek)
     uint8_t elf_header[64];
-    if (fs_read(&file, elf_header, 64) != 64) {
+    if (fs_read(file, elf_header, 64) != 64) {
         terminal_writestring("Hata: ELF baslik okunamadi!\n");
-        fs_close(&file);
+        fs_close(file);
+        fs_file_free(file);
         return 0;
     }
     
     // ELF dosyası mı kontrol et (sihirli sayı)
     if (elf_header[0] != 0x7F || elf_header[1] != 'E' || elf_header[2] != 'L' || elf_header[3] != 'F') {
         terminal_writestring("Hata: Gecerli bir ELF dosyasi degil!\n");
-        fs_close(&file);
+        fs_close(file);
+        fs_file_free(file);
         return 0;
     }
     
     // 64-bit ELF mi?
     if (elf_header[4] != 2) { // ELFCLASS64
         terminal_writestring("Hata: 64-bit ELF dosyasi degil!\n");
-        fs_close(&file);
+        fs_close(file);
+        fs_file_free(file);
         return 0;
     }
     
     // Yürütülebilir mi?
     if (elf_header[16] != 2) { // ET_EXEC
         terminal_writestring("Hata: Yurutulebilir dosya degil!\n");
-        fs_close(&file);
+        fs_close(file);
+        fs_file_free(file);
         return 0;
     }
     
@@ -248,11 +285,15 @@ int usermode_load_program(process_t* process, const char* filename) {
     // Giriş noktasını al
     uint64_t entry_point = *((uint64_t*)(elf_header + 24)); // e_entry
     
+    // Önceki program görüntüsü varsa tamamen bırak
+    usermode_release_address_space(process);
+    
     // Kullanıcı adres alanı oluştur
     void* user_pml4 = paging_create_user_address_space();
     if (!user_pml4) {
         terminal_writestring("Hata: Kullanici adres alani olusturulamadi!\n");
-        fs_close(&file);
+        fs_close(file);
+        fs_file_free(file);
         return 0;
     }
     
@@ -260,15 +301,18 @@ int usermode_load_program(process_t* process, const char* filename) {
     process->page_directory = (uint64_t)user_pml4;
     
     // Program başlıklarını oku ve yükle
+    uint64_t image_end = 0;
     for (uint16_t i = 0; i < ph_count; i++) {
         // Dosya konumunu ayarla
-        fs_seek(&file, ph_offset + i * ph_size);
+        fs_seek(file, ph_offset + i * ph_size);
         
         // Program başlığını oku
         uint8_t ph_data[56]; // sizeof(Elf64_Phdr)
-        if (fs_read(&file, ph_data, 56) != 56) {
+        if (fs_read(file, ph_data, 56) != 56) {
             terminal_writestring("Hata: Program basligi okunamadi!\n");
-            fs_close(&file);
+            usermode_release_address_space(process);
+            fs_close(file);
+            fs_file_free(file);
             return 0;
         }
         
@@ -287,61 +331,53 @@ int usermode_load_program(process_t* process, const char* filename) {
         uint64_t p_offset = *((uint64_t*)(ph_data + 8));  // p_offset
         uint32_t p_flags = *((uint32_t*)(ph_data + 4));   // p_flags
         
-        // Bellek ayır ve sayfa eşlemeleri oluştur
-        uint64_t page_count = (p_memsz + PAGE_SIZE - 1) / PAGE_SIZE;
-        
-        // Sayfa hizalama
-        uint64_t vaddr_aligned = p_vaddr & ~0xFFF;
-        uint64_t offset_in_page = p_vaddr & 0xFFF;
-        
         // Sayfa bayraklarını oluştur
-        uint64_t page_flags = PAGE_PRESENT;
+        uint32_t vma_flags = VMA_READ;
+        if (p_flags & 0x1) { // PF_X
+            vma_flags |= VMA_EXEC;
+        }
         if (p_flags & 0x2) { // PF_W
-            page_flags |= PAGE_WRITABLE;
+            vma_flags |= VMA_WRITE;
         }
         
-        // Sayfaları eşle
-        for (uint64_t j = 0; j < page_count; j++) {
-            uint64_t vaddr = vaddr_aligned + j * PAGE_SIZE;
-            
-            // Sayfa tahsis et
-            void* page = paging_alloc_user_page(user_pml4, (void*)vaddr, page_flags);
-            if (!page) {
-                terminal_writestring("Hata: Kullanici sayfasi tahsis edilemedi!\n");
-                fs_close(&file);
-                return 0;
-            }
-            
-            // İlk sayfada offset var mı?
-            uint64_t page_offset = (j == 0) ? offset_in_page : 0;
-            
-            // Dosyadan verileri oku
-            if (j * PAGE_SIZE < p_filesz) {
-                uint64_t bytes_to_read = PAGE_SIZE - page_offset;
-                if (j * PAGE_SIZE + bytes_to_read > p_filesz) {
-                    bytes_to_read = p_filesz - j * PAGE_SIZE;
-                }
-                
-                // Dosya konumunu ayarla
-                fs_seek(&file, p_offset + j * PAGE_SIZE);
-                
-                // Sayfa içeriğini oku
-                fs_read(&file, (void*)(vaddr + page_offset), bytes_to_read);
-            }
+        // Segment için yalnız bölge kaydedilir; sayfalar ilk erişimde
+        // sayfa hatası işleyicisi tarafından tahsis edilip dosyadan doldurulur
+        if (!vma_add(&process->vmas, p_vaddr, p_vaddr + p_memsz, vma_flags, file, p_offset, p_vaddr, p_filesz)) {
+            terminal_writestring("Hata: Program bolgesi olusturulamadi!\n");
+            usermode_release_address_space(process);
+            fs_close(file);
+            fs_file_free(file);
+            return 0;
+        }
+        
+        if (p_vaddr + p_memsz > image_end) {
+            image_end = p_vaddr + p_memsz;
         }
     }
     
-    // Kullanıcı yığını oluştur
+    // Program sonu (brk) görüntünün bittiği sayfadan başlar
+    process->brk_start = (image_end + PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1);
+    process->brk = process->brk_start;
+    
+    // Kullanıcı yığını bölgesi (tepe adresi içeren sayfa dahil)
     uint64_t stack_size = 64 * 1024; // 64 KB
-    uint64_t stack_bottom = USER_STACK_TOP - stack_size;
+    uint64_t stack_end = (USER_STACK_TOP + 1) & ~(uint64_t)(PAGE_SIZE - 1);
     
-    // Yığın sayfalarını eşle
-    for (uint64_t addr = stack_bottom; addr < USER_STACK_TOP; addr += PAGE_SIZE) {
-        if (!paging_alloc_user_page(user_pml4, (void*)addr, PAGE_PRESENT | PAGE_WRITABLE | PAGE_USER)) {
-            terminal_writestring("Hata: Kullanici yigini tahsis edilemedi!\n");
-            fs_close(&file);
-            return 0;
-        }
+    if (!vma_add(&process->vmas, stack_end - stack_size, stack_end, VMA_READ | VMA_WRITE, NULL, 0, 0, 0)) {
+        terminal_writestring("Hata: Kullanici yigini tahsis edilemedi!\n");
+        usermode_release_address_space(process);
+        fs_close(file);
+        fs_file_free(file);
+        return 0;
+    }
+    
+    // Zaman ve kimlik bilgisini sistem çağrısız sunan vDSO sayfaları
+    if (!vdso_map(process)) {
+        terminal_writestring("Hata: vDSO eslenemedi!\n");
+        usermode_release_address_space(process);
+        fs_close(file);
+        fs_file_free(file);
+        return 0;
     }
     
     // İşlem bilgilerini güncelle
@@ -349,7 +385,8 @@ int usermode_load_program(process_t* process, const char* filename) {
     process->registers.rsp = USER_STACK_TOP;
     
     // Dosyayı kapat
-    fs_close(&file);
+    fs_close(file);
+    fs_file_free(file);
     
     return 1; // Başarılı
 }
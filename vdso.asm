@@ -0,0 +1,117 @@
+; Kullanıcı alanına kopyalanan vDSO kod sayfası
+; Kod konumdan bağımsızdır; veri sayfalarına sabit adreslerden erişir
+bits 64
+
+; vdso.h ile aynı tutulmalı
+VDSO_VVAR_ADDR equ 0x00007FFFFF000000
+VDSO_PROC_ADDR equ 0x00007FFFFF001000
+VDSO_TSC_SHIFT equ 32
+
+; vdso_time_t alan konumları
+VVAR_SEQ         equ 0
+VVAR_TICKS       equ 8
+VVAR_TICK_HZ     equ 16
+VVAR_NS_PER_TICK equ 24
+VVAR_TSC         equ 32
+VVAR_TSC_MULT    equ 40
+
+; vdso_proc_t alan konumları
+PROC_PID  equ 0
+PROC_PPID equ 8
+
+global vdso_code_start
+global vdso_code_end
+
+; Çekirdekte çalıştırılmaz, yalnız kopyalanır
+section .rodata
+
+align 16
+vdso_code_start:
+
+; Giriş tablosu: her işlev 16 baytlık sabit konumda (VDSO_FN_* ofsetleri)
+    jmp vdso_getpid             ; 0x00
+    align 16
+    jmp vdso_getppid            ; 0x10
+    align 16
+    jmp vdso_get_ticks          ; 0x20
+    align 16
+    jmp vdso_clock_gettime      ; 0x30
+    align 16
+
+; uint64_t getpid()
+vdso_getpid:
+    mov rdx, VDSO_PROC_ADDR
+    mov rax, [rdx + PROC_PID]
+    ret
+
+; uint64_t getppid()
+vdso_getppid:
+    mov rdx, VDSO_PROC_ADDR
+    mov rax, [rdx + PROC_PPID]
+    ret
+
+; uint64_t get_ticks()
+vdso_get_ticks:
+    mov rdx, VDSO_VVAR_ADDR
+.retry:
+    mov rcx, [rdx + VVAR_SEQ]
+    test rcx, 1                 ; Tek: çekirdek güncelliyor
+    jnz .wait
+    mov rax, [rdx + VVAR_TICKS]
+    cmp rcx, [rdx + VVAR_SEQ]   ; Okuma sırasında değiştiyse tekrarla
+    jne .retry
+    ret
+.wait:
+    pause
+    jmp .retry
+
+; int clock_gettime(vdso_timespec_t* ts) - açılıştan beri geçen süre
+; RDI = ts; dönüş 0
+vdso_clock_gettime:
+    mov r8, VDSO_VVAR_ADDR
+.retry:
+    mov r9, [r8 + VVAR_SEQ]
+    test r9, 1
+    jnz .wait
+    mov r10, [r8 + VVAR_TICKS]
+    mov r11, [r8 + VVAR_NS_PER_TICK]
+    mov rsi, [r8 + VVAR_TSC]
+    mov rcx, [r8 + VVAR_TSC_MULT]
+    cmp r9, [r8 + VVAR_SEQ]
+    jne .retry
+
+    ; Son tike kadar geçen süre
+    mov rax, r10
+    mul r11
+    mov r10, rax
+
+    ; TSC kalibre edildiyse son tikten bu yana geçen kısmı ekle
+    test rcx, rcx
+    jz .split
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    sub rax, rsi
+    mul rcx
+    shrd rax, rdx, VDSO_TSC_SHIFT
+    cmp rax, r11                ; Bir tikten uzun olamaz (tekdüze kalsın)
+    jb .add
+    lea rax, [r11 - 1]
+.add:
+    add r10, rax
+
+.split:
+    ; Saniye ve nanosaniyeye ayır
+    mov rax, r10
+    xor edx, edx
+    mov rcx, 1000000000
+    div rcx
+    mov [rdi], rax
+    mov [rdi + 8], rdx
+    xor eax, eax
+    ret
+.wait:
+    pause
+    jmp .retry
+
+vdso_code_end:
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "kernel.h"
+#include "vdso.h"
+#include "process.h"
+#include "paging.h"
+#include "vma.h"
+
+// vdso.asm'deki kullanıcı kodu
+extern char vdso_code_start[];
+extern char vdso_code_end[];
+
+// Tüm adres alanlarında ortak sayfalar (fiziksel)
+static void* vvar_phys = NULL;
+static void* code_phys = NULL;
+static vdso_time_t* vvar = NULL;
+
+// TSC kalibrasyonu
+static uint64_t calibrate_tick = 0;
+static uint64_t calibrate_tsc = 0;
+
+static inline uint64_t vdso_rdtsc() {
+    uint32_t low, high;
+    asm volatile("rdtsc" : "=a" (low), "=d" (high));
+    return ((uint64_t)high << 32) | low;
+}
+
+// Ortak sayfaları oluştur; sayfalar hiç serbest bırakılmaz
+void vdso_init(uint32_t tick_hz) {
+    vvar_phys = paging_alloc_page(PAGE_ALLOC_ZERO);
+    code_phys = paging_alloc_page(PAGE_ALLOC_ZERO);
+    if (!vvar_phys || !code_phys) {
+        terminal_writestring("Hata: vDSO sayfalari ayrilamadi!\n");
+        return;
+    }
+
+    // Referans sayımına girmesinler (adres alanları yıkılınca serbest kalmasınlar)
+    paging_phys_to_page(vvar_phys)->flags |= PG_RESERVED;
+    paging_phys_to_page(code_phys)->flags |= PG_RESERVED;
+
+    memcpy(phys_to_virt((uint64_t)code_phys), vdso_code_start, vdso_code_end - vdso_code_start);
+
+    vvar = (vdso_time_t*)phys_to_virt((uint64_t)vvar_phys);
+    vvar->tick_hz = tick_hz;
+    vvar->ns_per_tick = 1000000000ULL / tick_hz;
+
+    terminal_writestring("vDSO sayfalari hazirlandi.\n");
+}
+
+// Zamanlayıcı kesmesinden çağrılır: tik ve TSC bilgisini yayınla
+void vdso_timer_tick(uint64_t ticks) {
+    if (!vvar) {
+        return;
+    }
+
+    uint64_t tsc = vdso_rdtsc();
+
+    // İlk tikten itibaren VDSO_CALIBRATE_TICKS tik boyunca TSC hızını ölç
+    uint64_t mult = vvar->tsc_mult;
+    if (calibrate_tick == 0) {
+        calibrate_tick = ticks;
+        calibrate_tsc = tsc;
+    } else if (mult == 0 && ticks - calibrate_tick >= VDSO_CALIBRATE_TICKS) {
+        uint64_t tsc_per_tick = (tsc - calibrate_tsc) / (ticks - calibrate_tick);
+        if (tsc_per_tick) {
+            mult = (vvar->ns_per_tick << VDSO_TSC_SHIFT) / tsc_per_tick;
+        }
+    }
+
+    vvar->seq++;
+    asm volatile("" : : : "memory");
+    vvar->ticks = ticks;
+    vvar->tsc_at_tick = tsc;
+    vvar->tsc_mult = mult;
+    asm volatile("" : : : "memory");
+    vvar->seq++;
+}
+
+// Sürece özel sayfayı eşleyip kimlik bilgisini yaz
+// Çekirdek sayfaya doğrudan eşlemeden yazar; sahipsiz eşlenir ki geri kazanımda
+// bölgesinden (sıfırla) yeniden üretilmeye çalışılmasın
+static int vdso_map_proc_frame(process_t* process, void* frame) {
+    void* mapped = paging_map_user_frame((void*)process->page_directory, (void*)VDSO_PROC_ADDR, frame, PAGE_PRESENT);
+    paging_page_put(frame);
+    if (!mapped) {
+        return 0;
+    }
+
+    vdso_update_process(process);
+    return 1;
+}
+
+// vDSO sayfalarını sürecin adres alanına eşle (program yüklenirken)
+int vdso_map(process_t* process) {
+    void* user_pml4 = (void*)process->page_directory;
+    if (!vvar || !user_pml4) {
+        return 0;
+    }
+
+    // Bölgeler kaydedilir ki mmap bu adresleri vermesin; çerçeveler tüm süreçlerde
+    // ortak olduğundan kullanıcı izinlerini değiştiremez ya da bölgeyi kaldıramaz
+    if (!vma_add(&process->vmas, VDSO_VVAR_ADDR, VDSO_CODE_ADDR, VMA_READ | VMA_SPECIAL, NULL, 0, 0, 0) ||
+        !vma_add(&process->vmas, VDSO_CODE_ADDR, VDSO_END, VMA_READ | VMA_EXEC | VMA_SPECIAL, NULL, 0, 0, 0)) {
+        return 0;
+    }
+
+    if (!paging_map_user_frame(user_pml4, (void*)VDSO_VVAR_ADDR, vvar_phys, PAGE_PRESENT) ||
+        !paging_map_user_frame(user_pml4, (void*)VDSO_CODE_ADDR, code_phys, PAGE_PRESENT)) {
+        return 0;
+    }
+
+    void* frame = paging_alloc_page(PAGE_ALLOC_ZERO);
+    return frame && vdso_map_proc_frame(process, frame);
+}
+
+// Çoğaltılan adres alanında ebeveynin kimlik sayfası yerine yenisini eşle
+int vdso_fork(process_t* child) {
+    void* user_pml4 = (void*)child->page_directory;
+    if (!user_pml4 || !paging_user_to_kernel(user_pml4, (void*)VDSO_PROC_ADDR)) {
+        return 1; // vDSO eşlenmemiş
+    }
+
+    // Yeni çerçeve önce ayrılır; başarısızlıkta ebeveynin sayfası yerinde kalır
+    void* frame = paging_alloc_page(PAGE_ALLOC_ZERO);
+    if (!frame) {
+        return 0;
+    }
+
+    // Tablo zaten var, eşleme yeniden yapılabilir
+    paging_free_user_page(user_pml4, (void*)VDSO_PROC_ADDR);
+    return vdso_map_proc_frame(child, frame);
+}
+
+// Sürecin kimlik sayfasını güncelle (oluşturma, fork, yeni ebeveyn)
+void vdso_update_process(process_t* process) {
+    if (!process->page_directory) {
+        return;
+    }
+
+    vdso_proc_t* proc = (vdso_proc_t*)paging_user_to_kernel((void*)process->page_directory, (void*)VDSO_PROC_ADDR);
+    if (proc) {
+        proc->pid = process->pid;
+        proc->ppid = process->parent_pid;
+    }
+}
\ No newline at end of file
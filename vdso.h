@@ -0,0 +1,56 @@
+#ifndef VDSO_H
+#define VDSO_H
+
+#include <stdint.h>
+#include "process.h"
+
+// Her kullanıcı adres alanında yığının altındaki sabit sayfalar (vdso.asm ile aynı)
+#define VDSO_BASE      0x00007FFFFF000000
+#define VDSO_VVAR_ADDR VDSO_BASE                  // Ortak zaman verisi (salt okunur)
+#define VDSO_PROC_ADDR (VDSO_BASE + 0x1000)       // Sürece özel kimlik verisi (salt okunur)
+#define VDSO_CODE_ADDR (VDSO_BASE + 0x2000)       // Kullanıcı işlevleri (çalıştırılabilir)
+#define VDSO_END       (VDSO_BASE + 0x3000)
+
+// Kod sayfasındaki giriş noktaları (16 bayt aralıklı)
+#define VDSO_FN_GETPID        (VDSO_CODE_ADDR + 0x00)  // uint64_t getpid()
+#define VDSO_FN_GETPPID       (VDSO_CODE_ADDR + 0x10)  // uint64_t getppid()
+#define VDSO_FN_GET_TICKS     (VDSO_CODE_ADDR + 0x20)  // uint64_t get_ticks()
+#define VDSO_FN_CLOCK_GETTIME (VDSO_CODE_ADDR + 0x30)  // int clock_gettime(vdso_timespec_t*)
+
+// TSC farkı ns'ye (fark * tsc_mult) >> VDSO_TSC_SHIFT ile çevrilir
+#define VDSO_TSC_SHIFT 32
+
+// TSC bu kadar tik boyunca ölçülerek kalibre edilir
+#define VDSO_CALIBRATE_TICKS 50
+
+// Ortak zaman verisi; seq tekse çekirdek güncelliyordur, okuyucu
+// seq'i öncesinde ve sonrasında okuyup değişmişse tekrarlar
+typedef struct {
+    volatile uint64_t seq;       // Sıra sayacı
+    uint64_t ticks;              // Açılıştan beri zamanlayıcı tiki
+    uint64_t tick_hz;            // Tik frekansı
+    uint64_t ns_per_tick;        // Bir tikin süresi (ns)
+    uint64_t tsc_at_tick;        // Son tikteki TSC değeri
+    uint64_t tsc_mult;           // TSC çarpanı (0 = henüz kalibre edilmedi)
+} vdso_time_t;
+
+// Sürece özel veri
+typedef struct {
+    uint64_t pid;
+    uint64_t ppid;
+} vdso_proc_t;
+
+// clock_gettime sonucu (açılıştan beri)
+typedef struct {
+    int64_t tv_sec;
+    int64_t tv_nsec;
+} vdso_timespec_t;
+
+// vDSO işlevleri
+void vdso_init(uint32_t tick_hz);
+void vdso_timer_tick(uint64_t ticks);
+int vdso_map(process_t* process);
+int vdso_fork(process_t* child);
+void vdso_update_process(process_t* process);
+
+#endif // VDSO_H
\ No newline at end of file
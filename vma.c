@@ -0,0 +1,554 @@
+#include "kernel.h"
+#include "vma.h"
+#include "process.h"
+#include "idt.h"
+#include "paging.h"
+#include "slab.h"
+#include "signals.h"
+#include "shm.h"
+
+// Bölge tanımlayıcıları için nesne önbelleği
+static kmem_cache_t* vma_cache = NULL;
+
+static inline int vma_height(vm_area_t* vma) {
+    return vma ? vma->height : 0;
+}
+
+static void vma_update_height(vm_area_t* vma) {
+    int lh = vma_height(vma->left);
+    int rh = vma_height(vma->right);
+    vma->height = (lh > rh ? lh : rh) + 1;
+}
+
+static vm_area_t* vma_rotate_right(vm_area_t* vma) {
+    vm_area_t* left = vma->left;
+    vma->left = left->right;
+    left->right = vma;
+    vma_update_height(vma);
+    vma_update_height(left);
+    return left;
+}
+
+static vm_area_t* vma_rotate_left(vm_area_t* vma) {
+    vm_area_t* right = vma->right;
+    vma->right = right->left;
+    right->left = vma;
+    vma_update_height(vma);
+    vma_update_height(right);
+    return right;
+}
+
+// Alt ağacı dengele
+static vm_area_t* vma_balance(vm_area_t* vma) {
+    vma_update_height(vma);
+    int balance = vma_height(vma->left) - vma_height(vma->right);
+
+    if (balance > 1) {
+        if (vma_height(vma->left->left) < vma_height(vma->left->right)) {
+            vma->left = vma_rotate_left(vma->left);
+        }
+        return vma_rotate_right(vma);
+    }
+
+    if (balance < -1) {
+        if (vma_height(vma->right->right) < vma_height(vma->right->left)) {
+            vma->right = vma_rotate_right(vma->right);
+        }
+        return vma_rotate_left(vma);
+    }
+
+    return vma;
+}
+
+// Bölgeyi başlangıç adresine göre ağaca ekle
+static vm_area_t* vma_tree_insert(vm_area_t* root, vm_area_t* vma) {
+    if (!root) {
+        vma->left = NULL;
+        vma->right = NULL;
+        vma->height = 1;
+        return vma;
+    }
+
+    if (vma->start < root->start) {
+        root->left = vma_tree_insert(root->left, vma);
+    } else {
+        root->right = vma_tree_insert(root->right, vma);
+    }
+    return vma_balance(root);
+}
+
+// En soldaki düğümü ayır
+static vm_area_t* vma_tree_remove_min(vm_area_t* root, vm_area_t** min) {
+    if (!root->left) {
+        *min = root;
+        return root->right;
+    }
+
+    root->left = vma_tree_remove_min(root->left, min);
+    return vma_balance(root);
+}
+
+// Verilen adresle başlayan bölgeyi ağaçtan çıkar
+static vm_area_t* vma_tree_remove(vm_area_t* root, uint64_t start) {
+    if (!root) {
+        return NULL;
+    }
+
+    if (start < root->start) {
+        root->left = vma_tree_remove(root->left, start);
+    } else if (start > root->start) {
+        root->right = vma_tree_remove(root->right, start);
+    } else {
+        if (!root->left) {
+            return root->right;
+        }
+        if (!root->right) {
+            return root->left;
+        }
+
+        // Yerine sağ alt ağacın en küçüğü geçer
+        vm_area_t* successor;
+        vm_area_t* right = vma_tree_remove_min(root->right, &successor);
+        successor->left = root->left;
+        successor->right = right;
+        return vma_balance(successor);
+    }
+    return vma_balance(root);
+}
+
+// addr'den önce başlayan en yakın bölge (listede araya girme noktası)
+static vm_area_t* vma_find_prev(vm_map_t* map, uint64_t addr) {
+    vm_area_t* vma = map->root;
+    vm_area_t* prev = NULL;
+    while (vma) {
+        if (vma->start < addr) {
+            prev = vma;
+            vma = vma->right;
+        } else {
+            vma = vma->left;
+        }
+    }
+    return prev;
+}
+
+// Boş bölge dizini
+void vma_map_init(vm_map_t* map) {
+    map->head = NULL;
+    map->root = NULL;
+    map->cache = NULL;
+    map->count = 0;
+}
+
+// Adresi kapsayan bölgeyi bul
+vm_area_t* vma_find(vm_map_t* map, uint64_t addr) {
+    vm_area_t* vma = map->cache;
+    if (vma && vma->start <= addr && addr < vma->end) {
+        return vma;
+    }
+
+    vma = map->root;
+    while (vma) {
+        if (addr < vma->start) {
+            vma = vma->left;
+        } else if (addr >= vma->end) {
+            vma = vma->right;
+        } else {
+            map->cache = vma;
+            return vma;
+        }
+    }
+    return NULL;
+}
+
+// Listeye ve ağaca yeni bölge ekle; çakışan bölge kabul edilmez
+// Dosya verilirse bölge kendi kopyasını tutar, çağıran dosyayı kapatabilir
+vm_area_t* vma_add(vm_map_t* map, uint64_t start, uint64_t end, uint32_t flags,
+                   fs_file_t* file, uint64_t file_offset, uint64_t file_start, uint64_t file_size) {
+    start &= ~(uint64_t)(PAGE_SIZE - 1);
+    end = (end + PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1);
+    if (start >= end) {
+        return NULL;
+    }
+
+    // Araya girilecek yeri bul
+    vm_area_t* prev = vma_find_prev(map, start);
+    vm_area_t* next = prev ? prev->next : map->head;
+    if ((prev && prev->end > start) || (next && next->start < end)) {
+        terminal_writestring("Hata: Bellek bolgeleri cakisiyor!\n");
+        return NULL;
+    }
+
+    vm_area_t* vma = (vm_area_t*)kmem_cache_alloc(vma_cache);
+    if (!vma) {
+        return NULL;
+    }
+
+    vma->start = start;
+    vma->end = end;
+    vma->flags = flags;
+    vma->file = NULL;
+    vma->file_offset = file_offset;
+    vma->file_start = file_start;
+    vma->file_size = file_size;
+    vma->shm = NULL;
+
+    if (file && file_size) {
+        vma->file = fs_file_alloc();
+        if (!vma->file) {
+            kmem_cache_free(vma_cache, vma);
+            return NULL;
+        }
+        *vma->file = *file;
+    }
+
+    vma->next = next;
+    if (prev) {
+        prev->next = vma;
+    } else {
+        map->head = vma;
+    }
+    map->root = vma_tree_insert(map->root, vma);
+    map->count++;
+    return vma;
+}
+
+// Anonim bölge ekle; aynı izinli bitişik anonim bölgeyle birleştirilir (brk, mmap)
+vm_area_t* vma_add_anon(vm_map_t* map, uint64_t start, uint64_t end, uint32_t flags) {
+    start &= ~(uint64_t)(PAGE_SIZE - 1);
+    end = (end + PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1);
+
+    vm_area_t* prev = vma_find_prev(map, start);
+    vm_area_t* next = prev ? prev->next : map->head;
+    if (prev && prev->end == start && prev->flags == flags && !prev->file && !prev->shm &&
+        start < end && (!next || next->start >= end)) {
+        // Ağaç anahtarı (başlangıç) değişmez
+        prev->end = end;
+        return prev;
+    }
+
+    return vma_add(map, start, end, flags, NULL, 0, 0, 0);
+}
+
+// [base, limit) içinde size baytlık boş aralık bul (0 = yer yok)
+uint64_t vma_find_free(vm_map_t* map, uint64_t base, uint64_t limit, uint64_t size) {
+    uint64_t addr = base;
+    vm_area_t* prev = vma_find_prev(map, base);
+    if (prev && prev->end > addr) {
+        addr = prev->end;
+    }
+
+    for (vm_area_t* vma = prev ? prev->next : map->head; vma; vma = vma->next) {
+        if (vma->start >= addr + size) {
+            break;
+        }
+        if (vma->end > addr) {
+            addr = vma->end;
+        }
+    }
+    return addr + size <= limit ? addr : 0;
+}
+
+// Bölge tanımlayıcısını ve tuttuğu dosya/segment referansını bırak
+static void vma_release(vm_area_t* vma) {
+    if (vma->file) {
+        fs_close(vma->file);
+        fs_file_free(vma->file);
+    }
+    if (vma->shm) {
+        shm_unref(vma->shm);
+    }
+    kmem_cache_free(vma_cache, vma);
+}
+
+// Bölgeyi dizinden çıkar ve serbest bırak (eşlenmiş sayfalara dokunmaz)
+void vma_remove(vm_map_t* map, vm_area_t* vma) {
+    vm_area_t* prev = vma_find_prev(map, vma->start);
+    if (prev) {
+        prev->next = vma->next;
+    } else {
+        map->head = vma->next;
+    }
+
+    map->root = vma_tree_remove(map->root, vma->start);
+    if (map->cache == vma) {
+        map->cache = NULL;
+    }
+    map->count--;
+    vma_release(vma);
+}
+
+// Tüm bölgeleri serbest bırak (eşlenmiş sayfalara dokunmaz)
+void vma_free_all(vm_map_t* map) {
+    vm_area_t* vma = map->head;
+    while (vma) {
+        vm_area_t* next = vma->next;
+        vma_release(vma);
+        vma = next;
+    }
+    vma_map_init(map);
+}
+
+// Bölge dizinini kopyala (fork); başarısızlıkta hedef boş kalır
+int vma_clone(vm_map_t* src, vm_map_t* dst) {
+    vma_map_init(dst);
+    for (vm_area_t* vma = src->head; vma; vma = vma->next) {
+        vm_area_t* copy = vma_add(dst, vma->start, vma->end, vma->flags, vma->file,
+                                  vma->file_offset, vma->file_start, vma->file_size);
+        if (!copy) {
+            vma_free_all(dst);
+            return 0;
+        }
+
+        // Paylaşılan bölge çocukta da aynı segmente bağlı kalır
+        if (vma->shm) {
+            copy->shm = vma->shm;
+            shm_ref(copy->shm);
+        }
+    }
+    return 1;
+}
+
+// Bölgeyi addr'de ikiye böl; vma [start, addr) olarak kalır, yeni parça döner
+static vm_area_t* vma_split(vm_map_t* map, vm_area_t* vma, uint64_t addr) {
+    uint64_t end = vma->end;
+    vma->end = addr;
+
+    // Dosya ve segment konumları mutlak adrese göre tutulduğundan parça aynen devralır
+    vm_area_t* tail = vma_add(map, addr, end, vma->flags, vma->file,
+                              vma->file_offset, vma->file_start, vma->file_size);
+    if (!tail) {
+        vma->end = end;
+        return NULL;
+    }
+
+    if (vma->shm) {
+        tail->shm = vma->shm;
+        shm_ref(tail->shm);
+    }
+    return tail;
+}
+
+// Aralıktaki eşlenmiş sayfaları kaldır (çerçeve ve takas yuvası referansları bırakılır)
+static void vma_unmap_pages(void* user_pml4, uint64_t start, uint64_t end) {
+    if (!user_pml4) {
+        return;
+    }
+
+    paging_free_user_range(user_pml4, (void*)start, (end - start) / PAGE_SIZE);
+}
+
+// Aralığa değen bölgelerin bayrakları (ör. VMA_SPECIAL, VMA_RDONLY denetimi için)
+static uint32_t vma_range_flags(vm_map_t* map, uint64_t start, uint64_t end) {
+    vm_area_t* prev = vma_find_prev(map, start);
+    vm_area_t* vma = (prev && prev->end > start) ? prev : (prev ? prev->next : map->head);
+    uint32_t flags = 0;
+    for (; vma && vma->start < end; vma = vma->next) {
+        flags |= vma->flags;
+    }
+    return flags;
+}
+
+// [start, end) aralığını bölgelerden çıkar
+int vma_unmap(vm_map_t* map, void* user_pml4, uint64_t start, uint64_t end) {
+    start &= ~(uint64_t)(PAGE_SIZE - 1);
+    end = (end + PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1);
+    if (vma_range_flags(map, start, end) & VMA_SPECIAL) {
+        return 0;
+    }
+
+    vm_area_t* prev = vma_find_prev(map, start);
+    vm_area_t* vma = (prev && prev->end > start) ? prev : (prev ? prev->next : map->head);
+
+    while (vma && vma->start < end) {
+        // Aralık dışında kalan baş ve son parçaları ayır
+        if (vma->start < start) {
+            if (!vma_split(map, vma, start)) {
+                return 0;
+            }
+            vma = vma->next;
+        }
+        if (vma->end > end && !vma_split(map, vma, end)) {
+            return 0;
+        }
+
+        vm_area_t* next = vma->next;
+        vma_unmap_pages(user_pml4, vma->start, vma->end);
+        vma_remove(map, vma);
+        vma = next;
+    }
+    return 1;
+}
+
+// [start, end) aralığının izinlerini değiştir; aralık tamamen bölgelerle kaplı olmalı
+int vma_protect(vm_map_t* map, void* user_pml4, uint64_t start, uint64_t end, uint32_t flags) {
+    start &= ~(uint64_t)(PAGE_SIZE - 1);
+    end = (end + PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1);
+
+    // Boşluk var mı?
+    uint64_t covered = start;
+    for (vm_area_t* vma = vma_find(map, start); vma && covered < end; vma = vma->next) {
+        if (vma->start > covered) {
+            break;
+        }
+        covered = vma->end;
+    }
+    if (covered < end) {
+        return 0;
+    }
+
+    // Ortak vDSO sayfaları değişmez; salt okunur bağlanan paylaşılan bellek yazılabilir olmaz
+    uint32_t range_flags = vma_range_flags(map, start, end);
+    if ((range_flags & VMA_SPECIAL) || ((flags & VMA_WRITE) && (range_flags & VMA_RDONLY))) {
+        return 0;
+    }
+
+    vm_area_t* vma = vma_find(map, start);
+    while (vma && vma->start < end) {
+        if (vma->start < start) {
+            if (!vma_split(map, vma, start)) {
+                return 0;
+            }
+            vma = vma->next;
+        }
+        if (vma->end > end && !vma_split(map, vma, end)) {
+            return 0;
+        }
+
+        vma->flags = flags | (vma->flags & VMA_RDONLY);
+
+        // Eşlenmiş sayfaların izinleri bölgeye uydurulur; erişilemeyen bölgenin
+        // sayfaları mevcut olmaktan çıkar
+        if (user_pml4) {
+            for (uint64_t page = vma->start; page < vma->end; page += PAGE_SIZE) {
+                paging_protect_user_page(user_pml4, (void*)page, flags & (VMA_READ | VMA_EXEC), flags & VMA_WRITE);
+            }
+        }
+        vma = vma->next;
+    }
+    return 1;
+}
+
+// Adresi kapsayan bölgeden sayfayı tahsis edip doldur
+int vma_fault_in(vm_map_t* map, void* user_pml4, uint64_t addr, int write) {
+    vm_area_t* vma = vma_find(map, addr);
+    if (!vma || !(vma->flags & (VMA_READ | VMA_EXEC))) {
+        return 0;
+    }
+
+    if (write && !(vma->flags & VMA_WRITE)) {
+        return 0;
+    }
+
+    // Eşlenmiş sayfaya yazma: ancak yazınca kopyala sayfasıysa geçerlidir
+    uint64_t page = addr & ~(uint64_t)(PAGE_SIZE - 1);
+    if (paging_user_to_kernel(user_pml4, (void*)page)) {
+        return write && paging_cow_fault(user_pml4, (void*)page);
+    }
+
+    // Erişimi kapatılmış çerçeve bölge yeniden erişilebilir olunca aynen geri görünür
+    if (paging_user_protnone(user_pml4, (void*)page)) {
+        paging_protect_user_page(user_pml4, (void*)page, 1, vma->flags & VMA_WRITE);
+        return 1;
+    }
+
+    uint64_t page_flags = PAGE_PRESENT;
+    if (vma->flags & VMA_WRITE) {
+        page_flags |= PAGE_WRITABLE;
+    }
+
+    // Takas alanına yazılmış sayfa diskten geri okunur
+    if (paging_user_swapped(user_pml4, (void*)page)) {
+        return paging_swap_in(user_pml4, (void*)page, page_flags);
+    }
+
+    // Paylaşılan bellek: segmentin çerçevesini eşle
+    if (vma->shm) {
+        void* frame = shm_get_frame(vma->shm, (page - vma->file_start) / PAGE_SIZE);
+        if (!frame) {
+            return 0;
+        }
+
+        uint64_t shm_flags = PAGE_PRESENT | PAGE_SHARED;
+        if (vma->flags & VMA_WRITE) {
+            shm_flags |= PAGE_WRITABLE;
+        }
+        return paging_map_user_frame(user_pml4, (void*)page, frame, shm_flags) != NULL;
+    }
+
+    // Sayfaya düşen dosya verisi [from, to); from >= to ise sayfa tamamen sıfırdır
+    uint64_t from = page;
+    uint64_t to = page;
+    if (vma->file) {
+        from = page > vma->file_start ? page : vma->file_start;
+        to = page + PAGE_SIZE;
+        if (to > vma->file_start + vma->file_size) {
+            to = vma->file_start + vma->file_size;
+        }
+    }
+
+    // Boş sayfa okunuyorsa ortak sıfır çerçevesi yeter; özel kopya ilk yazmada alınır
+    if (!write && from >= to) {
+        return paging_map_user_zero_page(user_pml4, (void*)page, vma->flags & VMA_WRITE) != NULL;
+    }
+
+    // Sıfırlanmış sayfa tahsis et ve eşle
+    if (!paging_alloc_user_page(user_pml4, (void*)page, page_flags)) {
+        return 0;
+    }
+
+    // Dosya verisini doğrudan eşleme üzerinden oku
+    if (from < to) {
+        uint8_t* dest = (uint8_t*)paging_user_to_kernel(user_pml4, (void*)page);
+        fs_seek(vma->file, vma->file_offset + (from - vma->file_start));
+        fs_read(vma->file, dest + (from - page), to - from);
+    }
+
+    return 1;
+}
+
+// Sayfa hatası işleyicisi (kesme 14)
+static void page_fault_handler(registers_t* regs) {
+    uint64_t fault_addr;
+    asm volatile("mov %%cr2, %0" : "=r" (fault_addr));
+
+    uint64_t cr3;
+    asm volatile("mov %%cr3, %0" : "=r" (cr3));
+
+    // Yüklü adres alanındaki kullanıcı adresi: eşlenmemişse bölgeden doldur,
+    // mevcut sayfaya yazmaysa yazınca kopyala olarak çöz
+    process_t* current = get_current_process();
+    int resolvable = !(regs->err_code & PF_PRESENT) || (regs->err_code & PF_WRITE);
+    if (current && current->page_directory && (cr3 & PAGE_ADDR_MASK) == current->page_directory &&
+        fault_addr < USER_STACK_TOP && resolvable && !(regs->err_code & PF_RSVD)) {
+        if (vma_fault_in(&current->vmas, (void*)current->page_directory, fault_addr, regs->err_code & PF_WRITE)) {
+            return;
+        }
+    }
+
+    // Kernel kendi hatasından kurtulamaz
+    if (!(regs->err_code & PF_USER)) {
+        terminal_writestring("Hata: Kernel modunda sayfa hatasi! Sistem durduruldu.\n");
+        while (1) {
+            asm volatile("cli; hlt");
+        }
+    }
+
+    terminal_writestring("Hata: Segmentasyon hatasi, PID=");
+    char pid_str[10];
+    int_to_string(current ? current->pid : 0, pid_str);
+    terminal_writestring(pid_str);
+    terminal_writestring("\n");
+
+    if (current) {
+        signal_send(current, SIGSEGV);
+        signal_handle_pending(current);
+    }
+}
+
+// Bölge önbelleğini oluştur ve sayfa hatası işleyicisini kaydet
+void vma_init() {
+    vma_cache = kmem_cache_create("vm_area", sizeof(vm_area_t), 0, NULL);
+    register_interrupt_handler(14, (isr_t)page_fault_handler);
+
+    terminal_writestring("Sayfa hatasi isleyicisi kaydedildi.\n");
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef VMA_H
+#define VMA_H
+
+#include <stdint.h>
+#include "filesystem.h"
+
+// Bölge erişim bayrakları
+#define VMA_READ   0x1   // Okunabilir
+#define VMA_WRITE  0x2   // Yazılabilir
+#define VMA_EXEC   0x4   // Çalıştırılabilir
+#define VMA_SPECIAL 0x8  // Kernelin eşlediği ortak sayfalar (vDSO); mprotect/munmap/shmdt dokunamaz
+#define VMA_RDONLY 0x10  // Salt okunur bağlanan paylaşılan bellek; mprotect yazılabilir yapamaz
+
+// Adres verilmeyen mmap eşlemelerinin arandığı kullanıcı bölgesi
+#define VMA_MMAP_BASE  0x0000200000000000
+#define VMA_MMAP_LIMIT 0x0000700000000000
+
+// Sayfa hatası kodu bitleri (CPU'nun yığına koyduğu hata kodu)
+#define PF_PRESENT 0x1   // Sayfa mevcuttu (koruma ihlali)
+#define PF_WRITE   0x2   // Yazma erişimi
+#define PF_USER    0x4   // Kullanıcı modunda oluştu
+#define PF_RSVD    0x8   // Ayrılmış bit ihlali
+#define PF_FETCH   0x10  // Komut okuma
+
+struct shm_segment;
+
+// Sanal bellek bölgesi: sayfaları ilk erişimde tahsis edilir
+// [file_start, file_start + file_size) aralığı dosyadan, geri kalanı sıfırla doldurulur
+// Paylaşılan bellek bölgesinde sayfalar segmentin çerçeveleridir, segmentin
+// başı file_start adresine denk gelir
+typedef struct vm_area {
+    uint64_t start;              // Başlangıç adresi (sayfa hizalı)
+    uint64_t end;                // Bitiş adresi (sayfa hizalı, hariç)
+    uint32_t flags;              // VMA_READ/VMA_WRITE/VMA_EXEC
+    fs_file_t* file;             // Destek dosyası (NULL = anonim)
+    uint64_t file_offset;        // file_start'a karşılık gelen dosya konumu
+    uint64_t file_start;         // Dosya verisinin başladığı sanal adres
+    uint64_t file_size;          // Dosyadan okunacak bayt sayısı
+    struct shm_segment* shm;     // Paylaşılan bellek segmenti (NULL = özel)
+    struct vm_area* next;        // Adrese göre sıralı sonraki bölge
+    struct vm_area* left;        // Arama ağacında küçük adresler
+    struct vm_area* right;       // Arama ağacında büyük adresler
+    int height;                  // AVL yüksekliği
+} vm_area_t;
+
+// Süreç bölge dizini: sıralı liste ve başlangıç adresine göre AVL ağacı
+typedef struct {
+    vm_area_t* head;             // En düşük adresli bölge
+    vm_area_t* root;             // Arama ağacının kökü
+    vm_area_t* cache;            // Son bulunan bölge (art arda erişimler için)
+    uint32_t count;              // Bölge sayısı
+} vm_map_t;
+
+// Bölge işlevleri
+void vma_init();
+void vma_map_init(vm_map_t* map);
+vm_area_t* vma_add(vm_map_t* map, uint64_t start, uint64_t end, uint32_t flags,
+                   fs_file_t* file, uint64_t file_offset, uint64_t file_start, uint64_t file_size);
+vm_area_t* vma_add_anon(vm_map_t* map, uint64_t start, uint64_t end, uint32_t flags);
+vm_area_t* vma_find(vm_map_t* map, uint64_t addr);
+uint64_t vma_find_free(vm_map_t* map, uint64_t base, uint64_t limit, uint64_t size);
+void vma_remove(vm_map_t* map, vm_area_t* vma);
+void vma_free_all(vm_map_t* map);
+int vma_clone(vm_map_t* src, vm_map_t* dst);
+
+// Aralıktaki bölgeleri gerekirse bölerek kaldır ya da izinlerini değiştir
+// (eşlenmiş sayfalar da güncellenir; 1 = başarılı)
+int vma_unmap(vm_map_t* map, void* user_pml4, uint64_t start, uint64_t end);
+int vma_protect(vm_map_t* map, void* user_pml4, uint64_t start, uint64_t end, uint32_t flags);
+
+// Adresi kapsayan bölgeden sayfayı tahsis edip doldur ya da yazınca
+// kopyala sayfasını çöz (1 = erişim artık geçerli)
+int vma_fault_in(vm_map_t* map, void* user_pml4, uint64_t addr, int write);
+
+#endif // VMA_H
\ No newline at end of file
@@ -0,0 +1,371 @@
+#include "kernel.h"
+#include "vmalloc.h"
+
+// Aralık düğümleri sabit havuzdan gelir (ayırıcının kendisi kmalloc_pages kullanamaz)
+static vmap_range_t range_nodes[VMALLOC_MAX_RANGES];
+static vmap_range_t* free_nodes = NULL;
+
+// Boş aralık ağacı
+static vmap_range_t* free_root = NULL;
+
+// Eşlemesi kaldırılmış ama TLB'de eski girişi kalabilecek aralıklar;
+// toplu temizlikten önce yeniden verilmezler
+static vmap_range_t* lazy_list = NULL;
+static uint64_t lazy_bytes = 0;
+
+static uint64_t purge_count = 0;
+
+// Boş düğüm al
+static vmap_range_t* node_alloc() {
+    vmap_range_t* node = free_nodes;
+    if (node) {
+        free_nodes = node->next;
+        node->next = NULL;
+    }
+    return node;
+}
+
+// Düğümü havuza geri ver
+static void node_free(vmap_range_t* node) {
+    node->next = free_nodes;
+    free_nodes = node;
+}
+
+static inline int node_height(vmap_range_t* node) {
+    return node ? node->height : 0;
+}
+
+static inline uint64_t node_max(vmap_range_t* node) {
+    return node ? node->max_size : 0;
+}
+
+// Yükseklik ve alt ağaç en büyük aralığını yeniden hesapla
+static void node_update(vmap_range_t* node) {
+    int lh = node_height(node->left);
+    int rh = node_height(node->right);
+    node->height = (lh > rh ? lh : rh) + 1;
+
+    node->max_size = node->size;
+    if (node_max(node->left) > node->max_size) {
+        node->max_size = node_max(node->left);
+    }
+    if (node_max(node->right) > node->max_size) {
+        node->max_size = node_max(node->right);
+    }
+}
+
+static vmap_range_t* rotate_right(vmap_range_t* node) {
+    vmap_range_t* left = node->left;
+    node->left = left->right;
+    left->right = node;
+    node_update(node);
+    node_update(left);
+    return left;
+}
+
+static vmap_range_t* rotate_left(vmap_range_t* node) {
+    vmap_range_t* right = node->right;
+    node->right = right->left;
+    right->left = node;
+    node_update(node);
+    node_update(right);
+    return right;
+}
+
+// Alt ağacı dengele
+static vmap_range_t* tree_balance(vmap_range_t* node) {
+    node_update(node);
+    int balance = node_height(node->left) - node_height(node->right);
+
+    if (balance > 1) {
+        if (node_height(node->left->left) < node_height(node->left->right)) {
+            node->left = rotate_left(node->left);
+        }
+        return rotate_right(node);
+    }
+
+    if (balance < -1) {
+        if (node_height(node->right->right) < node_height(node->right->left)) {
+            node->right = rotate_right(node->right);
+        }
+        return rotate_left(node);
+    }
+
+    return node;
+}
+
+// Aralığı başlangıç adresine göre ekle
+static vmap_range_t* tree_insert(vmap_range_t* root, vmap_range_t* node) {
+    if (!root) {
+        node->left = NULL;
+        node->right = NULL;
+        node_update(node);
+        return node;
+    }
+
+    if (node->start < root->start) {
+        root->left = tree_insert(root->left, node);
+    } else {
+        root->right = tree_insert(root->right, node);
+    }
+    return tree_balance(root);
+}
+
+// En soldaki düğümü ayır
+static vmap_range_t* tree_remove_min(vmap_range_t* root, vmap_range_t** min) {
+    if (!root->left) {
+        *min = root;
+        return root->right;
+    }
+
+    root->left = tree_remove_min(root->left, min);
+    return tree_balance(root);
+}
+
+// Verilen adresle başlayan aralığı ağaçtan çıkar (düğüm serbest bırakılmaz)
+static vmap_range_t* tree_remove(vmap_range_t* root, uint64_t start) {
+    if (!root) {
+        return NULL;
+    }
+
+    if (start < root->start) {
+        root->left = tree_remove(root->left, start);
+    } else if (start > root->start) {
+        root->right = tree_remove(root->right, start);
+    } else {
+        if (!root->left) {
+            return root->right;
+        }
+        if (!root->right) {
+            return root->left;
+        }
+
+        // Yerine sağ alt ağacın en küçüğü geçer
+        vmap_range_t* successor;
+        vmap_range_t* right = tree_remove_min(root->right, &successor);
+        successor->left = root->left;
+        successor->right = right;
+        return tree_balance(successor);
+    }
+    return tree_balance(root);
+}
+
+// need baytı karşılayan en düşük adresli aralığı bul
+static vmap_range_t* tree_find_fit(uint64_t need) {
+    vmap_range_t* node = free_root;
+    if (node_max(node) < need) {
+        return NULL;
+    }
+
+    while (node) {
+        if (node_max(node->left) >= need) {
+            node = node->left;
+        } else if (node->size >= need) {
+            return node;
+        } else {
+            node = node->right;
+        }
+    }
+    return NULL;
+}
+
+// addr'den önce başlayan en yakın aralık
+static vmap_range_t* tree_find_prev(uint64_t addr) {
+    vmap_range_t* node = free_root;
+    vmap_range_t* prev = NULL;
+    while (node) {
+        if (node->start < addr) {
+            prev = node;
+            node = node->right;
+        } else {
+            node = node->left;
+        }
+    }
+    return prev;
+}
+
+// addr'den sonra başlayan en yakın aralık
+static vmap_range_t* tree_find_next(uint64_t addr) {
+    vmap_range_t* node = free_root;
+    vmap_range_t* next = NULL;
+    while (node) {
+        if (node->start > addr) {
+            next = node;
+            node = node->left;
+        } else {
+            node = node->right;
+        }
+    }
+    return next;
+}
+
+// Aralığı ağaca geri koy, bitişik komşularla birleştir
+static void free_range_insert(vmap_range_t* node) {
+    vmap_range_t* prev = tree_find_prev(node->start);
+    if (prev && prev->start + prev->size == node->start) {
+        free_root = tree_remove(free_root, prev->start);
+        node->start = prev->start;
+        node->size += prev->size;
+        node_free(prev);
+    }
+
+    vmap_range_t* next = tree_find_next(node->start);
+    if (next && node->start + node->size == next->start) {
+        free_root = tree_remove(free_root, next->start);
+        node->size += next->size;
+        node_free(next);
+    }
+
+    free_root = tree_insert(free_root, node);
+}
+
+// Bekleyen aralıkların eski TLB girişlerini tek seferde temizle ve aralıkları geri ver
+void vmalloc_purge() {
+    if (!lazy_list) {
+        return;
+    }
+
+    // Kernel eşlemeleri global olduğundan tüm TLB temizlenir
+    paging_flush_tlb_all();
+    purge_count++;
+
+    while (lazy_list) {
+        vmap_range_t* node = lazy_list;
+        lazy_list = node->next;
+        node->next = NULL;
+        free_range_insert(node);
+    }
+    lazy_bytes = 0;
+}
+
+// Düğüm al; havuz boşsa bekleyen aralıkları birleştirerek yer aç
+static vmap_range_t* node_alloc_or_purge() {
+    vmap_range_t* node = node_alloc();
+    if (!node && lazy_list) {
+        vmalloc_purge();
+        node = node_alloc();
+    }
+    return node;
+}
+
+// Ardışık sayfalar için sanal adres ayır (arkasında koruma sayfası bırakılır)
+// align bayt cinsinden, sayfa boyutunun katı olmalı; 0 = başarısız
+uint64_t vmalloc_reserve(uint64_t pages, uint64_t align) {
+    if (pages == 0) {
+        return 0;
+    }
+    if (align < PAGE_SIZE) {
+        align = PAGE_SIZE;
+    }
+
+    uint64_t size = (pages + VMALLOC_GUARD_PAGES) * PAGE_SIZE;
+    uint64_t need = size + align - PAGE_SIZE;
+
+    // Aralık bölünürse ikinci düğüm gerekir, önceden ayır
+    vmap_range_t* spare = node_alloc_or_purge();
+    vmap_range_t* node = tree_find_fit(need);
+    if (!node && lazy_list) {
+        vmalloc_purge();
+        node = tree_find_fit(need);
+    }
+
+    if (!node || !spare) {
+        if (spare) {
+            node_free(spare);
+        }
+        terminal_writestring("Hata: Kernel sanal adres alani doldu!\n");
+        return 0;
+    }
+
+    free_root = tree_remove(free_root, node->start);
+
+    uint64_t addr = (node->start + align - 1) & ~(align - 1);
+    uint64_t range_end = node->start + node->size;
+
+    // Hizalamadan kalan ön parça
+    if (addr > node->start) {
+        node->size = addr - node->start;
+        free_root = tree_insert(free_root, node);
+        node = spare;
+        spare = NULL;
+    }
+
+    // Tahsisten sonra kalan arka parça
+    if (addr + size < range_end) {
+        node->start = addr + size;
+        node->size = range_end - node->start;
+        free_root = tree_insert(free_root, node);
+        node = NULL;
+    }
+
+    if (node) {
+        node_free(node);
+    }
+    if (spare) {
+        node_free(spare);
+    }
+
+    return addr;
+}
+
+// Eşlemesi kaldırılmış aralığı bırak; TLB temizliği toplu yapılana kadar yeniden verilmez
+void vmalloc_release(uint64_t addr, uint64_t pages) {
+    vmap_range_t* node = node_alloc_or_purge();
+    if (!node) {
+        terminal_writestring("Hata: Sanal adres araligi dugumu kalmadi!\n");
+        return;
+    }
+
+    node->start = addr;
+    node->size = (pages + VMALLOC_GUARD_PAGES) * PAGE_SIZE;
+    node->next = lazy_list;
+    lazy_list = node;
+    lazy_bytes += node->size;
+
+    if (lazy_bytes >= VMALLOC_LAZY_MAX_PAGES * PAGE_SIZE) {
+        vmalloc_purge();
+    }
+}
+
+// Adres ayırıcının bölgesinde mi?
+int vmalloc_contains(uint64_t addr) {
+    return addr >= VMALLOC_START && addr < VMALLOC_END;
+}
+
+// Ağacı dolaşarak boş aralıkları say
+static void vmalloc_count(vmap_range_t* node, vmalloc_info_t* info) {
+    if (!node) {
+        return;
+    }
+    info->free_bytes += node->size;
+    info->free_ranges++;
+    vmalloc_count(node->left, info);
+    vmalloc_count(node->right, info);
+}
+
+// Kullanım bilgilerini doldur
+void vmalloc_get_info(vmalloc_info_t* info) {
+    info->free_bytes = 0;
+    info->free_ranges = 0;
+    vmalloc_count(free_root, info);
+    info->lazy_bytes = lazy_bytes;
+    info->largest_free = node_max(free_root);
+    info->purge_count = purge_count;
+}
+
+// Düğüm havuzunu kur ve bölgenin tamamını tek boş aralık olarak ekle
+void vmalloc_init() {
+    free_nodes = NULL;
+    for (int i = VMALLOC_MAX_RANGES - 1; i >= 0; i--) {
+        node_free(&range_nodes[i]);
+    }
+
+    free_root = NULL;
+    lazy_list = NULL;
+    lazy_bytes = 0;
+
+    vmap_range_t* node = node_alloc();
+    node->start = VMALLOC_START;
+    node->size = VMALLOC_END - VMALLOC_START;
+    free_root = tree_insert(free_root, node);
+}
\ No newline at end of file
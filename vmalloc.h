@@ -0,0 +1,49 @@
+#ifndef VMALLOC_H
+#define VMALLOC_H
+
+#include <stdint.h>
+#include "paging.h"
+
+// kmalloc_pages tahsislerinin yapıldığı kernel sanal adres bölgesi
+#define VMALLOC_START KERNEL_BASE
+#define VMALLOC_END   0xFFFFFFFFFFE00000  // Son 2 MB kullanılmaz
+
+// Her tahsisin arkasında eşlenmemiş bırakılan koruma sayfası
+#define VMALLOC_GUARD_PAGES 1
+
+// Boş aralık düğümü havuzu
+#define VMALLOC_MAX_RANGES 512
+
+// Bu kadar sayfa TLB temizliği beklerse toplu temizlik yapılır
+#define VMALLOC_LAZY_MAX_PAGES 4096  // 16 MB
+
+// Boş sanal adres aralığı (başlangıç adresine göre AVL ağacı)
+// max_size alt ağaçtaki en büyük aralığı tutar, en düşük uygun adres tek inişte bulunur
+typedef struct vmap_range {
+    uint64_t start;              // Aralık başlangıcı (sayfa hizalı)
+    uint64_t size;               // Aralık boyutu (bayt)
+    uint64_t max_size;           // Alt ağaçtaki en büyük aralık
+    int height;                  // AVL yüksekliği
+    struct vmap_range* left;
+    struct vmap_range* right;
+    struct vmap_range* next;     // Boş düğüm ya da temizlik bekleyen aralık listesi
+} vmap_range_t;
+
+// Kullanım bilgileri
+typedef struct {
+    uint64_t free_bytes;         // Ağaçtaki boş adres alanı
+    uint64_t lazy_bytes;         // TLB temizliği bekleyen adres alanı
+    uint64_t free_ranges;        // Ağaçtaki aralık sayısı
+    uint64_t largest_free;       // En büyük boş aralık
+    uint64_t purge_count;        // Yapılan toplu temizlik sayısı
+} vmalloc_info_t;
+
+// Sanal adres ayırıcı işlevleri
+void vmalloc_init();
+uint64_t vmalloc_reserve(uint64_t pages, uint64_t align);
+void vmalloc_release(uint64_t addr, uint64_t pages);
+int vmalloc_contains(uint64_t addr);
+void vmalloc_purge();
+void vmalloc_get_info(vmalloc_info_t* info);
+
+#endif // VMALLOC_H
\ No newline at end of file
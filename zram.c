@@ -0,0 +1,431 @@
+#include "kernel.h"
+#include "zram.h"
+#include "paging.h"
+
+// Sıkıştırılmış sayfa girişi
+// refs == 0 ise giriş boştur ve data sonraki boş girişin numarasını tutar
+typedef struct {
+    uint64_t data;               // Nesne adresi ya da (size == 0 ise) sayfanın dolgu değeri
+    uint16_t size;               // Sıkıştırılmış boyut (0 = tek değerle dolu sayfa)
+    uint16_t refs;               // Girişi gösteren takas girişi sayısı
+} zram_entry_t;
+
+// Havuz sayfası başlığı; nesneler ZRAM_ZPAGE_HEADER ofsetinden başlar
+typedef struct zram_zpage {
+    struct zram_zpage* next;     // Sınıfta boş yeri olan sayfalar
+    struct zram_zpage* prev;
+    uint16_t class_index;        // Boyut sınıfı
+    uint16_t used;               // Kullanımdaki nesne
+    uint16_t capacity;           // Sayfadaki nesne sayısı
+    uint16_t free_head;          // İlk boş nesnenin ofseti (0 = yok)
+} zram_zpage_t;
+
+static zram_entry_t* zram_table = NULL;
+static uint64_t zram_free_head = 0;      // İlk boş giriş (ZRAM_MAX_PAGES = yok)
+
+// Boyut sınıfı başına boş yeri olan havuz sayfaları
+static zram_zpage_t* zram_classes[ZRAM_CLASS_COUNT];
+
+// Sıkıştırıcı çalışma alanı (kesmeler kapalıyken kullanılır)
+static uint16_t zram_hash[1 << ZRAM_HASH_BITS];
+static uint8_t zram_buffer[ZRAM_MAX_COMPRESSED];
+
+static zram_info_t zram_stats;
+
+static inline uint64_t zram_rdtsc() {
+    uint32_t low, high;
+    asm volatile("rdtsc" : "=a" (low), "=d" (high));
+    return ((uint64_t)high << 32) | low;
+}
+
+// Süre sayaçlarını güncelle
+static void zram_account(uint64_t* count, uint64_t* total, uint64_t* max, uint64_t cycles) {
+    (*count)++;
+    *total += cycles;
+    if (cycles > *max) {
+        *max = cycles;
+    }
+}
+
+// --- LZ sıkıştırıcı ---
+// Dizi: belirteç (üst 4 bit literal sayısı, alt 4 bit eşleşme uzunluğu - 4), 15 ise
+// uzunluk 255'lik ek baytlarla sürer; literaller; 2 baytlık geri uzaklık; ek eşleşme
+// uzunluğu. Son dizi yalnız literal taşır ve sayfanın sonunda biter
+
+// 15 ve üstü uzunluğun ek baytları
+static uint32_t zram_put_length(uint8_t* out, uint32_t length) {
+    uint32_t n = 0;
+    for (length -= 15; length >= 255; length -= 255) {
+        out[n++] = 255;
+    }
+    out[n++] = (uint8_t)length;
+    return n;
+}
+
+// Bir dizi yaz; match_length == 0 ise son dizidir. Yer yetmezse 0 döner
+static int zram_emit(uint32_t* op, const uint8_t* literals, uint32_t literal_length,
+                     uint32_t offset, uint32_t match_length) {
+    // En kötü durum: belirteç + uzunluk ekleri + literaller + uzaklık
+    uint32_t worst = 1 + (literal_length / 255 + 1) + literal_length + 2 + (match_length / 255 + 1);
+    if (*op + worst > ZRAM_MAX_COMPRESSED) {
+        return 0;
+    }
+
+    uint8_t* out = zram_buffer + *op;
+    uint32_t n = 1;
+    uint32_t match_code = match_length ? match_length - ZRAM_MIN_MATCH : 0;
+    out[0] = (uint8_t)(((literal_length < 15 ? literal_length : 15) << 4) | (match_code < 15 ? match_code : 15));
+
+    if (literal_length >= 15) {
+        n += zram_put_length(out + n, literal_length);
+    }
+    memcpy(out + n, literals, literal_length);
+    n += literal_length;
+
+    if (match_length) {
+        out[n++] = (uint8_t)offset;
+        out[n++] = (uint8_t)(offset >> 8);
+        if (match_code >= 15) {
+            n += zram_put_length(out + n, match_code);
+        }
+    }
+
+    *op += n;
+    return 1;
+}
+
+// Sayfayı zram_buffer'a sıkıştır; sonuç ZRAM_MAX_COMPRESSED'a sığmazsa 0 döner
+static uint32_t zram_compress(const uint8_t* src) {
+    memset(zram_hash, 0xFF, sizeof(zram_hash));
+
+    uint32_t ip = 0;
+    uint32_t anchor = 0;
+    uint32_t op = 0;
+    while (ip + ZRAM_MIN_MATCH <= PAGE_SIZE) {
+        uint32_t sequence = *(const uint32_t*)(src + ip);
+        uint32_t hash = (sequence * 2654435761U) >> (32 - ZRAM_HASH_BITS);
+        uint32_t ref = zram_hash[hash];
+        zram_hash[hash] = (uint16_t)ip;
+
+        if (ref == 0xFFFF || *(const uint32_t*)(src + ref) != sequence) {
+            ip++;
+            continue;
+        }
+
+        uint32_t length = ZRAM_MIN_MATCH;
+        while (ip + length < PAGE_SIZE && src[ref + length] == src[ip + length]) {
+            length++;
+        }
+        if (!zram_emit(&op, src + anchor, ip - anchor, ip - ref, length)) {
+            return 0;
+        }
+        ip += length;
+        anchor = ip;
+    }
+
+    if (!zram_emit(&op, src + anchor, PAGE_SIZE - anchor, 0, 0)) {
+        return 0;
+    }
+    return op;
+}
+
+// 15 ve üstü uzunluğun ek baytlarını oku
+static int zram_get_length(const uint8_t* src, uint32_t size, uint32_t* ip, uint32_t* length) {
+    uint8_t byte;
+    do {
+        if (*ip >= size) {
+            return 0;
+        }
+        byte = src[(*ip)++];
+        *length += byte;
+    } while (byte == 255);
+    return 1;
+}
+
+// Sıkıştırılmış veriyi sayfaya aç; bozuk veri sayfa dışına yazamaz
+static int zram_decompress(const uint8_t* src, uint32_t size, uint8_t* dest) {
+    uint32_t ip = 0;
+    uint32_t op = 0;
+    while (ip < size) {
+        uint8_t token = src[ip++];
+
+        uint32_t literal_length = token >> 4;
+        if (literal_length == 15 && !zram_get_length(src, size, &ip, &literal_length)) {
+            return 0;
+        }
+        if (ip + literal_length > size || op + literal_length > PAGE_SIZE) {
+            return 0;
+        }
+        memcpy(dest + op, src + ip, literal_length);
+        ip += literal_length;
+        op += literal_length;
+
+        // Son dizi
+        if (op == PAGE_SIZE) {
+            return ip == size;
+        }
+
+        if (ip + 2 > size) {
+            return 0;
+        }
+        uint32_t offset = src[ip] | ((uint32_t)src[ip + 1] << 8);
+        ip += 2;
+
+        uint32_t match_length = token & 0xF;
+        if (match_length == 15 && !zram_get_length(src, size, &ip, &match_length)) {
+            return 0;
+        }
+        match_length += ZRAM_MIN_MATCH;
+        if (offset == 0 || offset > op || op + match_length > PAGE_SIZE) {
+            return 0;
+        }
+
+        // Örtüşen kopya bayt bayt yapılır
+        for (uint32_t i = 0; i < match_length; i++, op++) {
+            dest[op] = dest[op - offset];
+        }
+    }
+    return 0;
+}
+
+// --- Nesne havuzu ---
+// Havuz sayfaları doğrudan fiziksel ayırıcıdan alınır; geri kazanım sırasında
+// kmalloc yığınına girilmez
+
+// Sınıf listesine ekle/çıkar
+static void zram_class_add(zram_zpage_t* zpage) {
+    zram_zpage_t** head = &zram_classes[zpage->class_index];
+    zpage->prev = NULL;
+    zpage->next = *head;
+    if (*head) {
+        (*head)->prev = zpage;
+    }
+    *head = zpage;
+}
+
+static void zram_class_remove(zram_zpage_t* zpage) {
+    if (zpage->prev) {
+        zpage->prev->next = zpage->next;
+    } else {
+        zram_classes[zpage->class_index] = zpage->next;
+    }
+    if (zpage->next) {
+        zpage->next->prev = zpage->prev;
+    }
+}
+
+// size baytlık nesne ayır (doğrudan eşleme adresi, yoksa 0)
+static uint64_t zram_obj_alloc(uint32_t size) {
+    uint32_t class_index = (size + ZRAM_CLASS_STEP - 1) / ZRAM_CLASS_STEP - 1;
+    zram_zpage_t* zpage = zram_classes[class_index];
+
+    if (!zpage) {
+        if (zram_stats.pool_pages >= zram_stats.pool_limit) {
+            return 0;
+        }
+        void* phys = paging_alloc_page(PAGE_ALLOC_ANY);
+        if (!phys) {
+            return 0;
+        }
+        zram_stats.pool_pages++;
+
+        // Nesneler boş listeye dizilir; her boş nesnenin ilk iki baytı sonrakinin ofseti
+        uint32_t stride = (class_index + 1) * ZRAM_CLASS_STEP;
+        zpage = (zram_zpage_t*)phys_to_virt((uint64_t)phys);
+        zpage->class_index = class_index;
+        zpage->used = 0;
+        zpage->capacity = (PAGE_SIZE - ZRAM_ZPAGE_HEADER) / stride;
+        zpage->free_head = ZRAM_ZPAGE_HEADER;
+        for (uint32_t i = 0; i < zpage->capacity; i++) {
+            uint32_t offset = ZRAM_ZPAGE_HEADER + i * stride;
+            *(uint16_t*)((uint8_t*)zpage + offset) = i + 1 < zpage->capacity ? offset + stride : 0;
+        }
+        zram_class_add(zpage);
+    }
+
+    uint64_t obj = (uint64_t)zpage + zpage->free_head;
+    zpage->free_head = *(uint16_t*)obj;
+    zpage->used++;
+    if (zpage->used == zpage->capacity) {
+        zram_class_remove(zpage);
+    }
+    return obj;
+}
+
+// Nesneyi bırak; boşalan havuz sayfası ayırıcıya döner
+static void zram_obj_free(uint64_t obj) {
+    zram_zpage_t* zpage = (zram_zpage_t*)(obj & ~(uint64_t)(PAGE_SIZE - 1));
+    if (zpage->used == zpage->capacity) {
+        zram_class_add(zpage);
+    }
+
+    *(uint16_t*)obj = zpage->free_head;
+    zpage->free_head = (uint16_t)(obj - (uint64_t)zpage);
+    zpage->used--;
+
+    if (zpage->used == 0) {
+        zram_class_remove(zpage);
+        paging_free_page((void*)virt_to_phys(zpage));
+        zram_stats.pool_pages--;
+    }
+}
+
+// Giriş tablosunu ve boş giriş zincirini hazırla
+int zram_init() {
+    memset(&zram_stats, 0, sizeof(zram_stats));
+    memset(zram_classes, 0, sizeof(zram_classes));
+
+    uint64_t table_pages = (ZRAM_MAX_PAGES * sizeof(zram_entry_t) + PAGE_SIZE - 1) / PAGE_SIZE;
+    zram_table = (zram_entry_t*)kmalloc_pages(table_pages);
+    if (!zram_table) {
+        terminal_writestring("Hata: Sikistirilmis bellek tablosu ayrilamadi!\n");
+        return 0;
+    }
+
+    for (uint64_t i = 0; i < ZRAM_MAX_PAGES; i++) {
+        zram_table[i].data = i + 1;
+    }
+    zram_free_head = 0;
+
+    zram_stats.max_pages = ZRAM_MAX_PAGES;
+    zram_stats.pool_limit = paging_get_pmm_info()->total_pages / ZRAM_MEMORY_DIVISOR;
+
+    terminal_writestring("Sikistirilmis bellek takasi etkin: ");
+    char size_str[20];
+    int_to_string(zram_stats.pool_limit * PAGE_SIZE / 1024, size_str);
+    terminal_writestring(size_str);
+    terminal_writestring(" KB havuz\n");
+    return 1;
+}
+
+// Sayfa sıkıştırılmış belleğe alınabilir mi?
+int zram_enabled() {
+    return zram_table != NULL;
+}
+
+// İstatistikleri al
+void zram_get_info(zram_info_t* info) {
+    *info = zram_stats;
+}
+
+// Sayfayı sıkıştırıp sakla; tek değerle dolu sayfa yalnız değeriyle tutulur
+int zram_store(void* phys_addr, uint64_t* index) {
+    if (!zram_table) {
+        return 0;
+    }
+
+    uint64_t rflags = irq_save();
+    if (zram_free_head >= ZRAM_MAX_PAGES) {
+        zram_stats.rejected++;
+        irq_restore(rflags);
+        return 0;
+    }
+
+    const uint8_t* src = (const uint8_t*)phys_to_virt((uint64_t)phys_addr);
+    const uint64_t* words = (const uint64_t*)src;
+    uint64_t start = zram_rdtsc();
+
+    uint32_t i = 1;
+    while (i < PAGE_SIZE / sizeof(uint64_t) && words[i] == words[0]) {
+        i++;
+    }
+
+    int same = i == PAGE_SIZE / sizeof(uint64_t);
+    uint32_t size = 0;
+    uint64_t data = words[0];
+    if (!same) {
+        size = zram_compress(src);
+        data = size ? zram_obj_alloc(size) : 0;
+        if (data) {
+            memcpy((void*)data, zram_buffer, size);
+        }
+    }
+    zram_account(&zram_stats.compress_count, &zram_stats.compress_cycles,
+                 &zram_stats.compress_max_cycles, zram_rdtsc() - start);
+
+    // Sıkışmayan ya da havuza sığmayan sayfa disk katmanına kalır
+    if (!same && !data) {
+        zram_stats.rejected++;
+        irq_restore(rflags);
+        return 0;
+    }
+
+    *index = zram_free_head;
+    zram_entry_t* entry = &zram_table[*index];
+    zram_free_head = entry->data;
+    entry->data = data;
+    entry->size = size;
+    entry->refs = 1;
+
+    zram_stats.stored_pages++;
+    if (size == 0) {
+        zram_stats.same_pages++;
+    } else {
+        zram_stats.compressed_bytes += size;
+        zram_stats.ratio[size < PAGE_SIZE / 8 ? 0 : (size < PAGE_SIZE / 4 ? 1 : 2)]++;
+    }
+    irq_restore(rflags);
+    return 1;
+}
+
+// Girişteki sayfayı çerçeveye aç
+int zram_load(uint64_t index, void* phys_addr) {
+    if (!zram_table || index >= ZRAM_MAX_PAGES) {
+        return 0;
+    }
+
+    uint64_t rflags = irq_save();
+    zram_entry_t* entry = &zram_table[index];
+    if (!entry->refs) {
+        irq_restore(rflags);
+        return 0;
+    }
+
+    uint64_t* dest = (uint64_t*)phys_to_virt((uint64_t)phys_addr);
+    uint64_t start = zram_rdtsc();
+    int loaded = 1;
+    if (entry->size == 0) {
+        for (uint32_t i = 0; i < PAGE_SIZE / sizeof(uint64_t); i++) {
+            dest[i] = entry->data;
+        }
+    } else {
+        loaded = zram_decompress((const uint8_t*)entry->data, entry->size, (uint8_t*)dest);
+    }
+    zram_account(&zram_stats.decompress_count, &zram_stats.decompress_cycles,
+                 &zram_stats.decompress_max_cycles, zram_rdtsc() - start);
+
+    irq_restore(rflags);
+    return loaded;
+}
+
+// Girişe bir sahip daha ekle
+void zram_dup(uint64_t index) {
+    if (zram_table && index < ZRAM_MAX_PAGES) {
+        uint64_t rflags = irq_save();
+        zram_table[index].refs++;
+        irq_restore(rflags);
+    }
+}
+
+// Girişin bir sahibini bırak; son sahip bırakınca veri ve giriş boşalır
+void zram_free(uint64_t index) {
+    if (!zram_table || index >= ZRAM_MAX_PAGES) {
+        return;
+    }
+
+    uint64_t rflags = irq_save();
+    zram_entry_t* entry = &zram_table[index];
+    if (entry->refs && --entry->refs == 0) {
+        if (entry->size) {
+            zram_obj_free(entry->data);
+            zram_stats.compressed_bytes -= entry->size;
+        } else {
+            zram_stats.same_pages--;
+        }
+        zram_stats.stored_pages--;
+
+        entry->data = zram_free_head;
+        zram_free_head = index;
+    }
+    irq_restore(rflags);
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#ifndef ZRAM_H
+#define ZRAM_H
+
+#include <stdint.h>
+
+// Sıkıştırılmış sayfa tablosu (16384 sayfa = 64 MB sıkıştırılmamış veri)
+#define ZRAM_MAX_PAGES       16384
+
+// Havuz sayfaları toplam belleğin en fazla 1/ZRAM_MEMORY_DIVISOR'ı kadar olur
+#define ZRAM_MEMORY_DIVISOR  4
+
+// Havuz sayfası: başlık + aynı boyut sınıfındaki nesneler
+#define ZRAM_ZPAGE_HEADER    32
+#define ZRAM_CLASS_STEP      32
+#define ZRAM_CLASS_COUNT     ((PAGE_SIZE - ZRAM_ZPAGE_HEADER) / 2 / ZRAM_CLASS_STEP)
+
+// Bundan büyük sıkışan sayfa havuz sayfasına ikiden az sığar, diske bırakılır
+#define ZRAM_MAX_COMPRESSED  (ZRAM_CLASS_COUNT * ZRAM_CLASS_STEP)
+
+// LZ sıkıştırıcı: 4 baytlık dizilerin karma tablosu, en kısa eşleşme 4 bayt
+#define ZRAM_HASH_BITS       10
+#define ZRAM_MIN_MATCH       4
+
+// Sıkıştırma oranı dağılımı (sıkıştırılmış boyut / sayfa): <%12,5, <%25, <%50
+#define ZRAM_RATIO_BUCKETS   3
+
+// Sıkıştırılmış bellek istatistikleri
+typedef struct {
+    uint64_t max_pages;              // Tablo boyutu (0 = kapalı)
+    uint64_t stored_pages;           // Saklanan sayfa
+    uint64_t same_pages;             // Tek değerle dolu (yer kaplamayan) sayfa
+    uint64_t compressed_bytes;       // Saklanan sıkıştırılmış veri
+    uint64_t pool_pages;             // Havuzun kullandığı fiziksel sayfa
+    uint64_t pool_limit;             // Havuz üst sınırı (sayfa)
+    uint64_t rejected;               // Sıkışmadığı ya da yer olmadığı için reddedilen
+    uint64_t ratio[ZRAM_RATIO_BUCKETS]; // Saklanırken ölçülen sıkıştırma oranı dağılımı
+    uint64_t compress_count;         // Sıkıştırma (reddedilenler dahil)
+    uint64_t compress_cycles;        // Toplam sıkıştırma süresi (TSC çevrimi)
+    uint64_t compress_max_cycles;    // En uzun sıkıştırma
+    uint64_t decompress_count;       // Açma
+    uint64_t decompress_cycles;      // Toplam açma süresi (TSC çevrimi)
+    uint64_t decompress_max_cycles;  // En uzun açma
+} zram_info_t;
+
+// Sıkıştırılmış bellek içi takas katmanı
+int zram_init();
+int zram_enabled();
+void zram_get_info(zram_info_t* info);
+
+// Sayfayı sıkıştırıp sakla, tablo girişini döndür (1 = saklandı)
+int zram_store(void* phys_addr, uint64_t* index);
+
+// Girişteki sayfayı çerçeveye aç (1 = başarılı)
+int zram_load(uint64_t index, void* phys_addr);
+
+// Giriş referansları (çoğaltılan adres alanları girişi paylaşır)
+void zram_dup(uint64_t index);
+void zram_free(uint64_t index);
+
+#endif // ZRAM_H
\ No newline at end of file